@@ -0,0 +1,179 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bench {
+    // #region types
+    struct Options {
+        std::size_t min_size = 1024;
+        std::size_t max_size = 1024 * 1024;
+        std::size_t min_repetitions = 5;
+        std::size_t max_repetitions = 1000;
+        std::chrono::nanoseconds budget = std::chrono::milliseconds(500);
+        std::string_view filter;
+    };
+
+    // a single timed pass over the input, returns the number of items parsed or 0 on failure
+    using Pass = std::function<std::size_t(std::string_view)>;
+
+    struct Case {
+        std::string name;
+        std::string (*generate)(std::size_t size);
+        Pass pass;
+    };
+
+    struct Stats {
+        std::size_t bytes = 0; // generators round down to whole tokens, so this can be below the nominal size
+        std::size_t items = 0;
+        std::size_t repetitions = 0;
+        double mb_per_s = 0.0;
+        double items_per_s = 0.0;
+        std::chrono::nanoseconds p50{};
+        std::chrono::nanoseconds p90{};
+        std::chrono::nanoseconds p99{};
+    };
+    // #endregion
+
+    // #region helpers
+    template <typename T>
+    inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static_cast<void>(*static_cast<const volatile char*>(static_cast<const void*>(&value)));
+#endif
+    }
+
+    inline auto percentile(const std::vector<std::chrono::nanoseconds>& sorted, double p) -> std::chrono::nanoseconds {
+        auto index = static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+        return sorted[std::min(index, sorted.size() - 1)];
+    }
+
+    inline auto measure(const Pass& pass, std::string_view input, const Options& options) -> Stats {
+        using clock = std::chrono::steady_clock;
+        std::vector<std::chrono::nanoseconds> samples;
+        std::size_t items = 0;
+        auto total = std::chrono::nanoseconds::zero();
+        while (samples.size() < options.max_repetitions &&
+            (samples.size() < options.min_repetitions || total < options.budget)) {
+            auto start = clock::now();
+            items = pass(input);
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start);
+            do_not_optimize(items);
+            samples.push_back(elapsed);
+            total += elapsed;
+        }
+
+        std::ranges::sort(samples);
+        Stats stats;
+        stats.bytes = input.size();
+        stats.items = items;
+        stats.repetitions = samples.size();
+        stats.p50 = percentile(samples, 0.50);
+        stats.p90 = percentile(samples, 0.90);
+        stats.p99 = percentile(samples, 0.99);
+        auto seconds = std::chrono::duration<double>(stats.p50).count();
+        if (seconds > 0.0) {
+            stats.mb_per_s = static_cast<double>(stats.bytes) / (1024.0 * 1024.0) / seconds;
+            stats.items_per_s = static_cast<double>(stats.items) / seconds;
+        }
+        return stats;
+    }
+
+    inline auto format_size(std::size_t size) -> std::string {
+        constexpr std::string_view units[] = {"B", "KB", "MB", "GB"};
+        std::size_t unit = 0;
+        while (unit + 1 < std::size(units) && size >= 1024 && size % 1024 == 0) {
+            size /= 1024;
+            ++unit;
+        }
+        return std::to_string(size) + std::string(units[unit]);
+    }
+
+    inline auto format_duration(std::chrono::nanoseconds duration) -> std::string {
+        char buffer[32];
+        auto ns = static_cast<double>(duration.count());
+        if (ns < 1e3) {
+            std::snprintf(buffer, sizeof(buffer), "%.0fns", ns);
+        } else if (ns < 1e6) {
+            std::snprintf(buffer, sizeof(buffer), "%.2fus", ns / 1e3);
+        } else if (ns < 1e9) {
+            std::snprintf(buffer, sizeof(buffer), "%.2fms", ns / 1e6);
+        } else {
+            std::snprintf(buffer, sizeof(buffer), "%.2fs", ns / 1e9);
+        }
+        return buffer;
+    }
+
+    // parses sizes like "1024", "64K", "1M" and "1G"
+    inline auto parse_size(std::string_view text) -> std::size_t {
+        std::size_t value = 0;
+        std::size_t i = 0;
+        for (; i < text.size() && text[i] >= '0' && text[i] <= '9'; ++i) {
+            value = value * 10 + static_cast<std::size_t>(text[i] - '0');
+        }
+        if (i < text.size()) {
+            switch (text[i]) {
+                case 'G': case 'g': value *= 1024; [[fallthrough]];
+                case 'M': case 'm': value *= 1024; [[fallthrough]];
+                case 'K': case 'k': value *= 1024; break;
+                default: break;
+            }
+        }
+        return value;
+    }
+
+    inline void print_header() {
+        std::printf("%-40s %8s %6s %12s %14s %10s %10s %10s\n",
+            "benchmark", "size", "reps", "MB/s", "items/s", "p50", "p90", "p99");
+    }
+
+    inline void print_row(std::string_view name, std::size_t size, const Stats& stats) {
+        std::printf("%-40.*s %8s %6zu %12.1f %14.0f %10s %10s %10s\n",
+            static_cast<int>(name.size()), name.data(),
+            format_size(size).c_str(),
+            stats.repetitions,
+            stats.mb_per_s,
+            stats.items_per_s,
+            format_duration(stats.p50).c_str(),
+            format_duration(stats.p90).c_str(),
+            format_duration(stats.p99).c_str());
+    }
+
+    // runs every case whose name contains options.filter over inputs growing by 32x from min_size to max_size
+    inline auto run(const std::vector<Case>& cases, const Options& options) -> int {
+        int failures = 0;
+        print_header();
+        for (std::size_t size = options.min_size; size <= options.max_size; size *= 32) {
+            std::string (*generated_by)(std::size_t) = nullptr;
+            std::string input;
+            for (const Case& c : cases) {
+                if (c.name.find(options.filter) == std::string::npos) {
+                    continue;
+                }
+                if (generated_by != c.generate) {
+                    input = c.generate(size);
+                    generated_by = c.generate;
+                }
+                Stats stats = measure(c.pass, input, options);
+                if (stats.items == 0) {
+                    std::printf("%-40s %8s FAILED\n", c.name.c_str(), format_size(size).c_str());
+                    ++failures;
+                    continue;
+                }
+                print_row(c.name, size, stats);
+            }
+            std::fflush(stdout);
+        }
+        return failures == 0 ? 0 : 1;
+    }
+    // #endregion
+} // namespace bench
@@ -0,0 +1,52 @@
+#include "cases.hpp"
+#include <chrono>
+#include <cstdio>
+#include <iterator>
+#include <string_view>
+#include <vector>
+
+namespace {
+    auto cases() -> std::vector<bench::Case> {
+        std::vector<bench::Case> result;
+        for (auto area : {bench::repetition_cases, bench::sequence_cases, bench::text_cases, bench::number_cases, bench::erased_cases}) {
+            std::vector<bench::Case> cases = area();
+            result.insert(result.end(), std::make_move_iterator(cases.begin()), std::make_move_iterator(cases.end()));
+        }
+        return result;
+    }
+
+    void usage(const char* program) {
+        std::printf(
+            "usage: %s [--filter <substring>] [--min-size <size>] [--max-size <size>] [--budget-ms <ms>]\n"
+            "sizes accept K, M and G suffixes, inputs grow by 32x from min-size to max-size (1K to 1G for the full suite)\n",
+            program);
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        std::string_view value = i + 1 < argc ? argv[i + 1] : "";
+        if (arg == "--filter") {
+            options.filter = value;
+        } else if (arg == "--min-size") {
+            options.min_size = bench::parse_size(value);
+        } else if (arg == "--max-size") {
+            options.max_size = bench::parse_size(value);
+        } else if (arg == "--budget-ms") {
+            options.budget = std::chrono::milliseconds(bench::parse_size(value));
+        } else {
+            usage(argv[0]);
+            return arg == "--help" ? 0 : 1;
+        }
+        ++i;
+    }
+
+    if (options.min_size == 0 || options.max_size < options.min_size) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    return bench::run(cases(), options);
+}
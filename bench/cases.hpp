@@ -0,0 +1,141 @@
+#pragma once
+
+#include "bench.hpp"
+#include <pc/pc.hpp>
+#include <pc/parsers.hpp>
+#include <pc/combinators.hpp>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace pc {
+    using namespace combinators;
+    using namespace parsers;
+}
+
+// the cases are spread over a translation unit per area, each compiling only the parsers it times, with the inputs
+// generated in generators.cpp
+namespace bench {
+    // #region generators
+    // the keywords of c89 up to static, double ahead of do as a choice of them has to try the longer one first
+    inline constexpr std::string_view c_keywords[] = {
+        "auto", "break", "case", "char", "const", "continue", "default", "double", "do", "else", "enum", "extern",
+        "float", "for", "goto", "if", "int", "long", "register", "return", "short", "signed", "sizeof", "static"};
+
+    auto letters(std::size_t size) -> std::string;
+    // lines of 0 to 79 lowercase letters, every line terminated by a newline
+    auto lines(std::size_t size) -> std::string;
+    // lines of 0 to 4095 lowercase letters, every line terminated by a newline. lines are kept shorter than size, so
+    // small sizes get at least one
+    auto long_lines(std::size_t size) -> std::string;
+    // a single line of lowercase letters filling size, terminated by a newline
+    auto one_long_line(std::size_t size) -> std::string;
+    // non empty lines joined by newlines, without a trailing newline, so every split is a whole line
+    auto joined_lines(std::size_t size) -> std::string;
+    auto hellos(std::size_t size) -> std::string;
+    // "hello,hello,...,hello"
+    auto comma_separated_hellos(std::size_t size) -> std::string;
+    auto key_values(std::size_t size) -> std::string;
+    // "x" tokens surrounded by 0 to 15 characters of mixed whitespace
+    auto padded(std::size_t size) -> std::string;
+    // "x" tokens on their own lines indented by 0 to 63 spaces, like pretty printed config or JSON
+    auto indented(std::size_t size) -> std::string;
+    // alphanumeric identifiers of 1 to 32 characters, each followed by a space
+    auto identifiers(std::size_t size) -> std::string;
+    auto keywords(std::size_t size) -> std::string;
+    // words of 1 to 8 lowercase letters, each followed by 6 marks that are '!' or '?' and a space
+    auto marked_words(std::size_t size) -> std::string;
+    // words of 1 to 8 lowercase letters, each followed by 0 to 4 '!' modifiers and a space
+    auto modified_words(std::size_t size) -> std::string;
+    // the 24 c_keywords in random order, back to back
+    auto statements(std::size_t size) -> std::string;
+    // unsigned integers of 1 to 19 digits, like a numeric column, each followed by a comma
+    auto numbers(std::size_t size) -> std::string;
+    // decimals of 1 to 17 significant digits with an exponent of -30 to 30, like a column of measurements, each
+    // followed by a comma
+    auto decimals(std::size_t size) -> std::string;
+    // lists of integers nesting up to 8 deep like [1,[2,[]],3], one per line
+    auto nested_lists(std::size_t size) -> std::string;
+    // sums and products of 1 to 16 integers below 1000 like 12+3*45-6, one per line
+    auto arithmetic_lines(std::size_t size) -> std::string;
+    // lists nesting 100000 deep like [[[]]], one per line, far deeper than the stack of a thread holds. sizes too
+    // small for one such line get a single line nesting as deep as fits
+    auto deep_lists(std::size_t size) -> std::string;
+    // where lines_file writes its input
+    auto lines_file_path() -> std::filesystem::path;
+    // lines, also written to lines_file_path() for the file input benchmarks to read back
+    auto lines_file(std::size_t size) -> std::string;
+    // #endregion
+
+    // #region drivers
+    // applies parser repeatedly until the input is consumed, counting one item per application
+    auto each(pc::AnyParser auto parser) -> Pass {
+        return [parser](std::string_view input) -> std::size_t {
+            std::size_t items = 0;
+            while (!input.empty()) {
+                auto result = std::invoke(parser, input);
+                if (!result) {
+                    return 0;
+                }
+                do_not_optimize(result->first);
+                input = result->second;
+                ++items;
+            }
+            return items;
+        };
+    }
+
+    // like each, but stops once no token is left, for inputs with trailing padding that no application consumes
+    auto each_token(pc::AnyParser auto parser, char token) -> Pass {
+        return [parser, token](std::string_view input) -> std::size_t {
+            std::size_t items = 0;
+            while (input.find(token) != std::string_view::npos) {
+                auto result = std::invoke(parser, input);
+                if (!result) {
+                    return 0;
+                }
+                do_not_optimize(result->first);
+                input = result->second;
+                ++items;
+            }
+            return items;
+        };
+    }
+
+    // applies a fold parser once to the whole input, the accumulator being the number of items
+    auto all_fold(pc::Parser<std::size_t> auto parser) -> Pass {
+        return [parser](std::string_view input) -> std::size_t {
+            auto result = std::invoke(parser, input);
+            return result && result->second.empty() ? result->first : 0;
+        };
+    }
+
+    // applies a repetition parser once to the whole input, counting one item per element produced
+    auto all(pc::AnyParser auto parser) -> Pass {
+        return [parser](std::string_view input) -> std::size_t {
+            auto result = std::invoke(parser, input);
+            if (!result || !result->second.empty()) {
+                return 0;
+            }
+            do_not_optimize(result->first);
+            return result->first.size();
+        };
+    }
+    // #endregion
+
+    // #region cases
+    // character and line repetitions, and the collections they fill
+    auto repetition_cases() -> std::vector<Case>;
+    // tags and the combinators sequencing and choosing between them
+    auto sequence_cases() -> std::vector<Case>;
+    // lines, whitespace and identifiers, in memory and from files
+    auto text_cases() -> std::vector<Case>;
+    // integers and decimals, against the standard library
+    auto number_cases() -> std::vector<Case>;
+    // ErasedParser, std::function, Rule and expression
+    auto erased_cases() -> std::vector<Case>;
+    // #endregion
+} // namespace bench
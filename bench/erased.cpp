@@ -0,0 +1,83 @@
+#include "cases.hpp"
+#include <pc/erased_parser.hpp>
+#include <pc/expression.hpp>
+#include <pc/rule.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace bench {
+    namespace {
+        // a value of nested_lists, counting the integers in it, with value parsing the values inside the lists
+        auto nested_list_of(pc::Parser<std::size_t> auto value) {
+            return pc::choice(
+                pc::map(pc::integer<std::uint32_t>(), [](std::uint32_t) { return std::size_t{1}; }),
+                pc::delimited(pc::tag('['), pc::many_seperated_by0_fold(value, pc::tag(','), std::size_t{0}, std::plus<>()), pc::tag(']')));
+        }
+
+        pc::Rule<std::size_t> nested_list_rule(pc::CharClass("0123456789["));
+
+        // the usual way to a recursive grammar without Rule, a std::function that the grammar calls back into
+        std::function<pc::Result<std::size_t>(std::string_view)> nested_list_function;
+
+        // the operators of arithmetic_lines as a table for expression, wrapping around like unsigned arithmetic does
+        const auto arithmetic = pc::expression(
+            pc::integer<std::uint64_t>(),
+            pc::infix(pc::tag('+'), 1, pc::Associativity::left, std::plus<>()),
+            pc::infix(pc::tag('-'), 1, pc::Associativity::left, std::minus<>()),
+            pc::infix(pc::tag('*'), 2, pc::Associativity::left, std::multiplies<>()));
+
+        // the same grammar with a layer per precedence, the way it is written without expression
+        const auto arithmetic_product = pc::map(
+            pc::pair(pc::integer<std::uint64_t>(), pc::many0(pc::preceded(pc::tag('*'), pc::integer<std::uint64_t>()))),
+            [](const std::pair<std::uint64_t, std::vector<std::uint64_t>>& factors) {
+                std::uint64_t product = factors.first;
+                for (std::uint64_t factor : factors.second) {
+                    product *= factor;
+                }
+                return product;
+            });
+        const auto arithmetic_layers = pc::map(
+            pc::pair(arithmetic_product, pc::many0(pc::pair(pc::choice(pc::tag('+'), pc::tag('-')), arithmetic_product))),
+            [](const std::pair<std::uint64_t, std::vector<std::pair<char, std::uint64_t>>>& terms) {
+                std::uint64_t sum = terms.first;
+                for (const auto& [op, term] : terms.second) {
+                    sum = op == '+' ? sum + term : sum - term;
+                }
+                return sum;
+            });
+    }
+
+    auto erased_cases() -> std::vector<Case> {
+        nested_list_rule.define(nested_list_of(nested_list_rule.ref()));
+        nested_list_function = nested_list_of([](std::string_view input) { return nested_list_function(input); });
+
+        return {
+            {"ErasedParser(tag_view(\"hello\"))", hellos, each(pc::ErasedParser<std::string_view>(pc::tag_view("hello")))},
+            {"std::function(tag_view(\"hello\"))", hellos, each(std::function<pc::Result<std::string_view>(std::string_view)>(pc::tag_view("hello")))},
+
+            {"terminated(ErasedParser(integer<uint64_t>()), ',')", numbers, each(pc::terminated(pc::ErasedParser<std::uint64_t>(pc::integer<std::uint64_t>()), pc::tag(',')))},
+            {"terminated(std::function(integer<uint64_t>()), ',')", numbers, each(pc::terminated(
+                std::function<pc::Result<std::uint64_t>(std::string_view)>(pc::integer<std::uint64_t>()), pc::tag(',')))},
+
+            {"choice(24 x ErasedParser(tag))", statements, each(std::apply([](auto... words) {
+                return pc::choice(pc::ErasedParser<std::string_view>(pc::tag_view(words))...);
+            }, std::to_array(c_keywords)))},
+            {"choice(24 x std::function(tag))", statements, each(std::apply([](auto... words) {
+                return pc::choice(std::function<pc::Result<std::string_view>(std::string_view)>(pc::tag_view(words))...);
+            }, std::to_array(c_keywords)))},
+
+            {"terminated(expression(integer<uint64_t>(), + - *), '\\n')", arithmetic_lines, each(pc::terminated(arithmetic, pc::tag('\n')))},
+            {"terminated(pair/many0 layer per precedence, '\\n')", arithmetic_lines, each(pc::terminated(arithmetic_layers, pc::tag('\n')))},
+
+            {"terminated(Rule(nested lists), '\\n')", nested_lists, each(pc::terminated(nested_list_rule.ref(), pc::tag('\n')))},
+            {"terminated(std::function(nested lists), '\\n')", nested_lists, each(pc::terminated(nested_list_function, pc::tag('\n')))},
+            {"terminated(Rule(deep lists), '\\n')", deep_lists, each(pc::terminated(nested_list_rule.ref(), pc::tag('\n')))},
+        };
+    }
+} // namespace bench
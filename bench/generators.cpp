@@ -0,0 +1,353 @@
+#include "cases.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+namespace bench {
+    namespace {
+        struct Random {
+            std::uint64_t state = 0x9e3779b97f4a7c15ull;
+
+            auto next() -> std::uint64_t {
+                state ^= state << 13;
+                state ^= state >> 7;
+                state ^= state << 17;
+                return state;
+            }
+
+            auto below(std::uint64_t n) -> std::size_t {
+                return static_cast<std::size_t>(next() % n);
+            }
+        };
+
+        auto repeat(std::string_view token, std::size_t size) -> std::string {
+            std::string result;
+            result.reserve(size);
+            while (result.size() + token.size() <= size) {
+                result.append(token);
+            }
+            return result;
+        }
+
+        // appends a list of up to 4 values, each one an integer below 1000 or, while depth is left, another list
+        void append_list(Random& random, std::size_t depth, std::string& result) {
+            result.push_back('[');
+            std::size_t count = random.below(5);
+            for (std::size_t i = 0; i < count; ++i) {
+                if (i > 0) {
+                    result.push_back(',');
+                }
+                if (depth > 0 && random.below(2) == 0) {
+                    append_list(random, depth - 1, result);
+                } else {
+                    result.append(std::to_string(random.below(1000)));
+                }
+            }
+            result.push_back(']');
+        }
+    }
+
+    auto letters(std::size_t size) -> std::string {
+        Random random;
+        std::string result(size, 'a');
+        for (char& c : result) {
+            c = static_cast<char>('a' + random.below(26));
+        }
+        return result;
+    }
+
+    auto lines(std::size_t size) -> std::string {
+        Random random;
+        std::string result;
+        result.reserve(size);
+        while (true) {
+            std::size_t length = random.below(80);
+            if (result.size() + length + 1 > size) {
+                break;
+            }
+            for (std::size_t i = 0; i < length; ++i) {
+                result.push_back(static_cast<char>('a' + random.below(26)));
+            }
+            result.push_back('\n');
+        }
+        return result;
+    }
+
+    auto long_lines(std::size_t size) -> std::string {
+        Random random;
+        std::string result;
+        result.reserve(size);
+        while (true) {
+            std::size_t length = random.below(std::min<std::size_t>(4096, size));
+            if (result.size() + length + 1 > size) {
+                break;
+            }
+            for (std::size_t i = 0; i < length; ++i) {
+                result.push_back(static_cast<char>('a' + random.below(26)));
+            }
+            result.push_back('\n');
+        }
+        return result;
+    }
+
+    auto one_long_line(std::size_t size) -> std::string {
+        std::string result = letters(size - 1);
+        result.push_back('\n');
+        return result;
+    }
+
+    auto joined_lines(std::size_t size) -> std::string {
+        Random random;
+        std::string result;
+        result.reserve(size);
+        while (true) {
+            std::size_t length = random.below(79) + 1;
+            if (result.size() + length + 1 > size) {
+                break;
+            }
+            if (!result.empty()) {
+                result.push_back('\n');
+            }
+            for (std::size_t i = 0; i < length; ++i) {
+                result.push_back(static_cast<char>('a' + random.below(26)));
+            }
+        }
+        return result;
+    }
+
+    auto hellos(std::size_t size) -> std::string {
+        return repeat("hello", size);
+    }
+
+    auto comma_separated_hellos(std::size_t size) -> std::string {
+        std::string result = repeat("hello,", size);
+        if (!result.empty()) {
+            result.pop_back();
+        }
+        return result;
+    }
+
+    auto key_values(std::size_t size) -> std::string {
+        return repeat("key=", size);
+    }
+
+    auto padded(std::size_t size) -> std::string {
+        Random random;
+        std::string result;
+        result.reserve(size);
+        while (true) {
+            std::size_t padding = random.below(16);
+            if (result.size() + padding + 1 > size) {
+                break;
+            }
+            for (std::size_t i = 0; i < padding; ++i) {
+                result.push_back(" \t\n"[random.below(3)]);
+            }
+            result.push_back('x');
+        }
+        return result;
+    }
+
+    auto indented(std::size_t size) -> std::string {
+        Random random;
+        std::string result;
+        result.reserve(size);
+        while (true) {
+            std::size_t indent = random.below(64);
+            if (result.size() + indent + 2 > size) {
+                break;
+            }
+            result.append(indent, ' ');
+            result.append("x\n");
+        }
+        return result;
+    }
+
+    auto identifiers(std::size_t size) -> std::string {
+        constexpr std::string_view alphabet = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+        Random random;
+        std::string result;
+        result.reserve(size);
+        while (true) {
+            std::size_t length = random.below(32) + 1;
+            if (result.size() + length + 1 > size) {
+                break;
+            }
+            for (std::size_t i = 0; i < length; ++i) {
+                result.push_back(alphabet[random.below(alphabet.size())]);
+            }
+            result.push_back(' ');
+        }
+        return result;
+    }
+
+    auto keywords(std::size_t size) -> std::string {
+        constexpr std::string_view words[] = {"alpha", "beta", "gamma", "delta"};
+        Random random;
+        std::string result;
+        result.reserve(size);
+        while (true) {
+            std::string_view word = words[random.below(std::size(words))];
+            if (result.size() + word.size() > size) {
+                break;
+            }
+            result.append(word);
+        }
+        return result;
+    }
+
+    auto marked_words(std::size_t size) -> std::string {
+        Random random;
+        std::string result;
+        result.reserve(size);
+        while (true) {
+            std::size_t length = random.below(8) + 1;
+            if (result.size() + length + 7 > size) {
+                break;
+            }
+            for (std::size_t i = 0; i < length; ++i) {
+                result.push_back(static_cast<char>('a' + random.below(26)));
+            }
+            for (std::size_t i = 0; i < 6; ++i) {
+                result.push_back(random.below(2) == 0 ? '!' : '?');
+            }
+            result.push_back(' ');
+        }
+        return result;
+    }
+
+    auto modified_words(std::size_t size) -> std::string {
+        Random random;
+        std::string result;
+        result.reserve(size);
+        while (true) {
+            std::size_t length = random.below(8) + 1;
+            std::size_t modifiers = random.below(5);
+            if (result.size() + length + modifiers + 1 > size) {
+                break;
+            }
+            for (std::size_t i = 0; i < length; ++i) {
+                result.push_back(static_cast<char>('a' + random.below(26)));
+            }
+            result.append(modifiers, '!');
+            result.push_back(' ');
+        }
+        return result;
+    }
+
+    auto statements(std::size_t size) -> std::string {
+        Random random;
+        std::string result;
+        result.reserve(size);
+        while (true) {
+            std::string_view word = c_keywords[random.below(std::size(c_keywords))];
+            if (result.size() + word.size() > size) {
+                break;
+            }
+            result.append(word);
+        }
+        return result;
+    }
+
+    auto numbers(std::size_t size) -> std::string {
+        Random random;
+        std::string result;
+        result.reserve(size);
+        while (true) {
+            std::size_t length = random.below(19) + 1;
+            if (result.size() + length + 1 > size) {
+                break;
+            }
+            result.push_back(static_cast<char>('1' + random.below(9)));
+            for (std::size_t i = 1; i < length; ++i) {
+                result.push_back(static_cast<char>('0' + random.below(10)));
+            }
+            result.push_back(',');
+        }
+        return result;
+    }
+
+    auto decimals(std::size_t size) -> std::string {
+        Random random;
+        std::string result;
+        result.reserve(size);
+        std::array<char, 32> number{};
+        while (true) {
+            double value = static_cast<double>(random.next() >> 11) / static_cast<double>(1ull << 53) * 2 - 1;
+            value *= std::pow(10.0, static_cast<double>(random.below(61)) - 30);
+            int length = std::snprintf(number.data(), number.size(), "%.*g", static_cast<int>(random.below(17) + 1), value);
+            if (result.size() + static_cast<std::size_t>(length) + 1 > size) {
+                break;
+            }
+            result.append(number.data(), static_cast<std::size_t>(length));
+            result.push_back(',');
+        }
+        return result;
+    }
+
+    auto nested_lists(std::size_t size) -> std::string {
+        Random random;
+        std::string result;
+        result.reserve(size);
+        std::string list;
+        while (true) {
+            list.clear();
+            append_list(random, 8, list);
+            if (result.size() + list.size() + 1 > size) {
+                break;
+            }
+            result.append(list);
+            result.push_back('\n');
+        }
+        return result;
+    }
+
+    auto arithmetic_lines(std::size_t size) -> std::string {
+        Random random;
+        std::string result;
+        result.reserve(size);
+        std::string line;
+        while (true) {
+            line = std::to_string(random.below(1000));
+            std::size_t operands = random.below(16) + 1;
+            for (std::size_t i = 1; i < operands; ++i) {
+                line.push_back("+-*"[random.below(3)]);
+                line.append(std::to_string(random.below(1000)));
+            }
+            if (result.size() + line.size() + 1 > size) {
+                break;
+            }
+            result.append(line);
+            result.push_back('\n');
+        }
+        return result;
+    }
+
+    auto deep_lists(std::size_t size) -> std::string {
+        const std::size_t depth = std::min<std::size_t>(100000, (size - 1) / 2);
+        std::string result;
+        result.reserve(size);
+        while (result.size() + 2 * depth + 1 <= size) {
+            result.append(depth, '[');
+            result.append(depth, ']');
+            result.push_back('\n');
+        }
+        return result;
+    }
+
+    auto lines_file_path() -> std::filesystem::path {
+        return std::filesystem::temp_directory_path() / "pc_benchmarks_lines.txt";
+    }
+
+    auto lines_file(std::size_t size) -> std::string {
+        std::string result = lines(size);
+        std::ofstream(lines_file_path(), std::ios::binary) << result;
+        return result;
+    }
+} // namespace bench
@@ -0,0 +1,72 @@
+#include "cases.hpp"
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace bench {
+    namespace {
+        // std::from_chars over every number of numbers, the floor for an integer parser
+        auto numbers_from_chars(std::string_view input) -> std::size_t {
+            std::size_t items = 0;
+            const char* end = input.data() + input.size();
+            for (const char* p = input.data(); p != end; ++p) {
+                std::uint64_t value = 0;
+                auto result = std::from_chars(p, end, value);
+                if (result.ec != std::errc() || result.ptr == end || *result.ptr != ',') {
+                    return 0;
+                }
+                do_not_optimize(value);
+                p = result.ptr;
+                ++items;
+            }
+            return items;
+        }
+
+        // std::strtod over every number of decimals, what parsers not reading from a string_view fall back on
+        auto decimals_strtod(std::string_view input) -> std::size_t {
+            // decimals are only ever followed by a comma, so strtod stops inside the string
+            std::size_t items = 0;
+            const char* end = input.data() + input.size();
+            for (const char* p = input.data(); p != end; ++p) {
+                char* number_end = nullptr;
+                double value = std::strtod(p, &number_end);
+                if (number_end == p || number_end == end || *number_end != ',') {
+                    return 0;
+                }
+                do_not_optimize(value);
+                p = number_end;
+                ++items;
+            }
+            return items;
+        }
+    }
+
+    auto number_cases() -> std::vector<Case> {
+        return {
+            {"terminated(map(many1(filter(character, is_digit))), ',')", numbers, each(pc::terminated(pc::map(
+                pc::many1(pc::filter(pc::character, pc::is_digit)), [](const std::vector<char>& digits) {
+                    std::uint64_t value = 0;
+                    for (char c : digits) {
+                        value = value * 10 + static_cast<std::uint64_t>(c - '0');
+                    }
+                    return value;
+                }), pc::tag(',')))},
+            {"terminated(integer<uint64_t>(), ',')", numbers, each(pc::terminated(pc::integer<std::uint64_t>(), pc::tag(',')))},
+            {"std::from_chars<uint64_t>", numbers, numbers_from_chars},
+
+            {"terminated(map(many1(filter(character, is_number)), stod), ',')", decimals, each(pc::terminated(pc::map(
+                pc::many1(pc::filter(pc::character, [](char c) {
+                    return pc::is_digit(c) || c == '-' || c == '+' || c == '.' || c == 'e';
+                })), [](const std::vector<char>& chars) {
+                    return std::stod(std::string(chars.begin(), chars.end()));
+                }), pc::tag(',')))},
+            {"terminated(floating_point<double>(), ',')", decimals, each(pc::terminated(pc::floating_point<double>(), pc::tag(',')))},
+            {"std::strtod", decimals, decimals_strtod},
+        };
+    }
+} // namespace bench
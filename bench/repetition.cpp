@@ -0,0 +1,65 @@
+#include "cases.hpp"
+#include <pc/arena.hpp>
+#include <pc/inline_vector.hpp>
+#include <pc/thread_pool.hpp>
+#include <cctype>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bench {
+    namespace {
+        // many0(line) with the vector and every line allocated from an arena that is released at the end of the pass
+        auto many0_line_in_arena(std::string_view input) -> std::size_t {
+            pc::Arena<64 * 1024> arena;
+            auto result = pc::many0(pc::pmr::line(arena), arena)(input);
+            if (!result || !result->second.empty()) {
+                return 0;
+            }
+            do_not_optimize(result->first);
+            return result->first.size();
+        }
+
+        // one worker per core, shared by every parallel case and started before the first one is timed
+        pc::ThreadPool pool;
+    }
+
+    auto repetition_cases() -> std::vector<Case> {
+        return {
+            {"manyn<4>(character)", letters, each(pc::manyn<4>(pc::character))},
+            {"many0(character)", letters, all(pc::many0(pc::character))},
+            {"map(character, toupper)", letters, each(pc::map(pc::character, [](char c) {
+                return static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+            }))},
+            {"filter(character, is_lower)", letters, each(pc::filter(pc::character, [](char c) {
+                return c >= 'a' && c <= 'z';
+            }))},
+
+            {"many0(line)", lines, all(pc::many0(pc::line))},
+            {"many0(line_view)", lines, all(pc::many0(pc::line_view))},
+            {"many0(pmr::line, arena)", lines, many0_line_in_arena},
+            {"many_split_by0(line, \"\\n\")", joined_lines, all(pc::many_split_by0(pc::line, "\n"))},
+            {"many_split_by0(line_view, \"\\n\")", joined_lines, all(pc::many_split_by0(pc::line_view, "\n"))},
+            {"par_many_split_by0(line, \"\\n\")", joined_lines, all(pc::par_many_split_by0(pc::line, "\n", pool))},
+            {"par_many_split_by0(line_view, \"\\n\")", joined_lines, all(pc::par_many_split_by0(pc::line_view, "\n", pool))},
+            {"recognize(many0(line))", lines, all(pc::recognize(pc::many0(pc::line)))},
+            {"recognize(many_split_by0(line, \"\\n\"))", joined_lines, all(pc::recognize(pc::many_split_by0(pc::line, "\n")))},
+
+            {"long many0(line_view)", long_lines, all(pc::many0(pc::line_view))},
+
+            {"many_seperated_by0(tag, tag(','))", comma_separated_hellos, all(pc::many_seperated_by0(pc::tag("hello"), pc::tag(',')))},
+            {"many_seperated_by0(tag_view, tag(','))", comma_separated_hellos, all(pc::many_seperated_by0(pc::tag_view("hello"), pc::tag(',')))},
+            {"recognize(many_seperated_by0(tag, tag(',')))", comma_separated_hellos, all(pc::recognize(pc::many_seperated_by0(pc::tag("hello"), pc::tag(','))))},
+
+            {"terminated(pair(take_while1(alpha), many0(tag('!'))), ' ')", modified_words, each(pc::terminated(pc::pair(
+                pc::take_while1(pc::char_classes::alpha), pc::many0(pc::tag('!'))), pc::tag(' ')))},
+            {"terminated(pair(take_while1(alpha), many0(tag('!'), InlineVector<char, 4>)), ' ')", modified_words, each(pc::terminated(pc::pair(
+                pc::take_while1(pc::char_classes::alpha), pc::many0(pc::tag('!'), pc::InlineVector<char, 4>())), pc::tag(' ')))},
+
+            {"pair(many1(filter(character, is_alnum)), ' ')", identifiers, each(pc::pair(pc::many1(pc::filter(pc::character, [](char c) {
+                return pc::char_classes::alnum.contains(c);
+            })), pc::tag(' ')))},
+        };
+    }
+} // namespace bench
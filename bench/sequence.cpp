@@ -0,0 +1,58 @@
+#include "cases.hpp"
+#include <pc/erased_parser.hpp>
+#include <pc/memo.hpp>
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace bench {
+    namespace {
+        // a word followed by depth marks, every level trying '!' before '?' so that a '?' parses the levels below it
+        // again. wrap is applied to every level, memo turns the 2^depth reparses into lookups. the levels are erased,
+        // as a type holding the level below twice over grows the debug info of its name exponentially with depth
+        auto marked(std::size_t depth, auto wrap) -> pc::ErasedParser<std::string_view> {
+            pc::ErasedParser<std::string_view> parser = wrap(pc::take_while1(pc::char_classes::alpha));
+            auto first = [](const std::pair<std::string_view, char>& p) { return p.first; };
+            for (std::size_t level = 0; level < depth; ++level) {
+                parser = wrap(pc::choice(pc::map(pc::pair(parser, pc::tag('!')), first), pc::map(pc::pair(parser, pc::tag('?')), first)));
+            }
+            return parser;
+        }
+
+        // each over a parser built with memo from context, reset before every pass
+        auto each_memo(pc::MemoContext& context, pc::AnyParser auto parser) -> Pass {
+            return [&context, pass = each(parser)](std::string_view input) -> std::size_t {
+                context.reset();
+                return pass(input);
+            };
+        }
+
+        pc::MemoContext memo_context;
+    }
+
+    auto sequence_cases() -> std::vector<Case> {
+        return {
+            {"tag(\"hello\")", hellos, each(pc::tag("hello"))},
+            {"tag_view(\"hello\")", hellos, each(pc::tag_view("hello"))},
+            {"tag<\"hello\">()", hellos, each(pc::tag<"hello">())},
+            {"tuple(tag('h'), character, tag(\"llo\"))", hellos, each(pc::tuple(pc::tag('h'), pc::character, pc::tag("llo")))},
+            {"tuple(tag('h'), ignore(character), tag_view(\"llo\"))", hellos, each(pc::tuple(pc::tag('h'), pc::ignore(pc::character), pc::tag_view("llo")))},
+            {"preceded(tag('h'), tag_view(\"ello\"))", hellos, each(pc::preceded(pc::tag('h'), pc::tag_view("ello")))},
+            {"pair(tag(\"key\"), tag('='))", key_values, each(pc::pair(pc::tag("key"), pc::tag('=')))},
+
+            {"choice(4 x tag)", keywords, each(pc::choice(pc::tag("alpha"), pc::tag("beta"), pc::tag("gamma"), pc::tag("delta")))},
+            {"choice(24 x tag)", statements, each(std::apply([](auto... words) {
+                return pc::choice(pc::tag_view(words)...);
+            }, std::to_array(c_keywords)))},
+            {"one_of_tags(24 keywords)", statements, each(pc::one_of_tags(c_keywords))},
+
+            {"marked(6, take_while1(alpha))", marked_words, each(pc::pair(marked(6, [](auto p) { return p; }), pc::tag(' ')))},
+            {"marked(6, take_while1(alpha)), memo", marked_words, each_memo(memo_context, pc::pair(marked(6, [](auto p) {
+                return pc::memo(memo_context, p);
+            }), pc::tag(' ')))},
+        };
+    }
+} // namespace bench
@@ -0,0 +1,80 @@
+#include "cases.hpp"
+#include <pc/incremental.hpp>
+#include <pc/mapped_input.hpp>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bench {
+    namespace {
+        const auto count_lines = pc::many0_fold(pc::line_view, std::size_t{0}, [](std::size_t n, std::string_view) { return n + 1; });
+
+        // the file is read into a string first, the way inputs were handed to parsers before parse_file
+        auto read_file_then_parse(std::string_view) -> std::size_t {
+            std::ifstream file(lines_file_path(), std::ios::binary);
+            std::string input(std::filesystem::file_size(lines_file_path()), '\0');
+            file.read(input.data(), static_cast<std::streamsize>(input.size()));
+            auto result = count_lines(input);
+            return result && result->second.empty() ? result->first : 0;
+        }
+
+        auto parse_mapped_file(std::string_view) -> std::size_t {
+            auto parsed = pc::parse_file(lines_file_path(), count_lines);
+            return parsed && parsed->result && parsed->result->second.empty() ? parsed->result->first : 0;
+        }
+
+        // feeds the input to incremental 16 bytes at a time, the way a socket or a pipe might hand it over, counting the
+        // items parsed
+        auto incremental_in_chunks(pc::AnyParser auto parser) -> Pass {
+            return [parser](std::string_view input) -> std::size_t {
+                auto items = pc::incremental(parser);
+                std::size_t count = 0;
+                while (true) {
+                    auto step = items.next();
+                    if (step.status == pc::Status::success) {
+                        do_not_optimize(step.value);
+                        ++count;
+                    } else if (step.status == pc::Status::incomplete) {
+                        if (input.empty()) {
+                            items.finish();
+                        } else {
+                            std::string_view chunk = input.substr(0, 16);
+                            input.remove_prefix(chunk.size());
+                            items.feed(chunk);
+                        }
+                    } else {
+                        return step.status == pc::Status::end ? count : 0;
+                    }
+                }
+            };
+        }
+    }
+
+    auto text_cases() -> std::vector<Case> {
+        return {
+            {"line", lines, each(pc::line)},
+            {"line_view", lines, each(pc::line_view)},
+            {"many0_fold(line_view, count)", lines, all_fold(count_lines)},
+            {"first_char_match(newline)", lines, each(pc::first_char_match([](char c) { return c == '\n'; }))},
+
+            {"file: read into string, count lines", lines_file, read_file_then_parse},
+            {"file: parse_file, count lines", lines_file, parse_mapped_file},
+
+            {"long line_view", long_lines, each(pc::line_view)},
+            {"long first_char_match(newline)", long_lines, each(pc::first_char_match([](char c) { return c == '\n'; }))},
+
+            {"trim(tag('x'))", padded, each_token(pc::trim(pc::tag('x')), 'x')},
+            {"indented trim(tag('x'))", indented, each_token(pc::trim(pc::tag('x')), 'x')},
+            {"indented trim_left(tag('x'))", indented, each_token(pc::trim_left(pc::tag('x')), 'x')},
+
+            {"incremental(line_view), 16B chunks", lines, incremental_in_chunks(pc::line_view)},
+            {"incremental(long line), 16B chunks", one_long_line, incremental_in_chunks(
+                pc::terminated(pc::take_while1(pc::char_classes::alpha), pc::tag('\n')))},
+
+            {"pair(take_while1(alnum), ' ')", identifiers, each(pc::pair(pc::take_while1(pc::char_classes::alnum), pc::tag(' ')))},
+        };
+    }
+} // namespace bench
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+
+namespace pc {
+    // #region types
+    // a monotonic memory resource for one parse: the first InlineCapacity bytes come from the arena itself, the rest
+    // from upstream in growing blocks, nothing is freed until release() or destruction, which free everything at once.
+    // like std::pmr::monotonic_buffer_resource it is not thread safe, use one arena per thread
+    template <std::size_t InlineCapacity = 4096>
+    class Arena {
+    public:
+        explicit Arena(std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+            : resource_(buffer_.data(), buffer_.size(), upstream) {}
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        auto resource() -> std::pmr::memory_resource* {
+            return &resource_;
+        }
+
+        operator std::pmr::memory_resource*() {
+            return resource();
+        }
+
+        // frees every allocation made from the arena, results allocated from it must not be used afterwards
+        void release() {
+            resource_.release();
+        }
+
+    private:
+        alignas(std::max_align_t) std::array<std::byte, InlineCapacity> buffer_;
+        std::pmr::monotonic_buffer_resource resource_;
+    };
+    // #endregion
+} // namespace pc
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <pc/pc.hpp>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <string_view>
+
+namespace pc {
+    // #region types
+    // a set of bytes as a 256 bit table, laid out by nibble so the simd kernels can classify a whole vector of bytes
+    // with two shuffles: table[low nibble] has bit n set when byte (n << 4 | low nibble) is in the class, for high
+    // nibbles 0 to 7, and table[16 + low nibble] does the same for high nibbles 8 to 15
+    struct CharClass {
+        std::array<std::uint8_t, 32> table{};
+
+        constexpr CharClass() = default;
+
+        constexpr explicit CharClass(std::string_view chars) {
+            for (char c : chars) {
+                insert(c);
+            }
+        }
+
+        static constexpr auto from(std::predicate<char> auto predicate) -> CharClass {
+            CharClass result;
+            for (int c = 0; c < 256; ++c) {
+                if (predicate(static_cast<char>(c))) {
+                    result.insert(static_cast<char>(c));
+                }
+            }
+            return result;
+        }
+
+        static constexpr auto range(char first, char last) -> CharClass {
+            CharClass result;
+            for (auto c = static_cast<unsigned char>(first); c <= static_cast<unsigned char>(last); ++c) {
+                result.insert(static_cast<char>(c));
+                if (c == 0xff) {
+                    break;
+                }
+            }
+            return result;
+        }
+
+        constexpr void insert(char c) {
+            auto byte = static_cast<unsigned char>(c);
+            table[index(byte)] = static_cast<std::uint8_t>(table[index(byte)] | bit(byte));
+        }
+
+        constexpr auto contains(char c) const -> bool {
+            auto byte = static_cast<unsigned char>(c);
+            return (table[index(byte)] & bit(byte)) != 0;
+        }
+
+        constexpr auto operator|(const CharClass& other) const -> CharClass {
+            CharClass result;
+            for (std::size_t i = 0; i < table.size(); ++i) {
+                result.table[i] = static_cast<std::uint8_t>(table[i] | other.table[i]);
+            }
+            return result;
+        }
+
+        constexpr auto operator&(const CharClass& other) const -> CharClass {
+            CharClass result;
+            for (std::size_t i = 0; i < table.size(); ++i) {
+                result.table[i] = static_cast<std::uint8_t>(table[i] & other.table[i]);
+            }
+            return result;
+        }
+
+        constexpr auto operator~() const -> CharClass {
+            CharClass result;
+            for (std::size_t i = 0; i < table.size(); ++i) {
+                result.table[i] = static_cast<std::uint8_t>(~table[i]);
+            }
+            return result;
+        }
+
+        constexpr auto operator==(const CharClass&) const -> bool = default;
+
+    private:
+        static constexpr auto index(unsigned char byte) -> std::size_t {
+            return (byte >= 0x80 ? 16u : 0u) + (byte & 0x0fu);
+        }
+
+        static constexpr auto bit(unsigned char byte) -> std::uint8_t {
+            return static_cast<std::uint8_t>(1u << ((byte >> 4) & 0x07u));
+        }
+    };
+    // #endregion
+
+    namespace char_classes {
+        inline constexpr CharClass whitespace{"\n\t "};
+        inline constexpr CharClass digit = CharClass::from(is_digit);
+        inline constexpr CharClass lower = CharClass::range('a', 'z');
+        inline constexpr CharClass upper = CharClass::range('A', 'Z');
+        inline constexpr CharClass alpha = lower | upper;
+        inline constexpr CharClass alnum = alpha | digit;
+        inline constexpr CharClass hex_digit = digit | CharClass::range('a', 'f') | CharClass::range('A', 'F');
+    } // namespace char_classes
+} // namespace pc
@@ -2,216 +2,914 @@
 #pragma once
 
 #include <pc/pc.hpp>
+#include <pc/char_class.hpp>
+#include <pc/first_set.hpp>
+#include <pc/recognizer.hpp>
+#include <pc/simd.hpp>
+#include <pc/thread_pool.hpp>
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <iterator>
+#include <memory_resource>
 #include <string_view>
 #include <ranges>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
+// every combinator but filter and many0_to_many1, which need the values they are given, is Recognizable: recognizing it
+// recognizes its parsers in turn, so recognize(grammar) constructs no value anywhere in the grammar
 namespace pc::combinators {
     template <std::size_t Count>
     auto manyn(AnyParser auto parser)
     -> Parser<std::array<ParserValueType<decltype(parser)>, Count>> auto {
         using Element = ParserValueType<decltype(parser)>;
-        return [parser](std::string_view input) -> Result<std::array<Element, Count>> {
-            std::array<Element, Count> result;
-            for (Element& x : result) {
-                if (auto p = std::invoke(parser, input)) {
+        return recognizable([parser](std::string_view input, auto mode) -> ModeResult<decltype(mode), std::array<Element, Count>> {
+            if constexpr (recognizing<decltype(mode)>) {
+                for (std::size_t i = 0; i < Count; ++i) {
+                    auto p = skip(parser, input);
+                    if (!p) {
+                        return p.error();
+                    }
+                    input = p->second;
+                }
+                return success(Ignored(), input);
+            } else {
+                std::array<Element, Count> result;
+                for (Element& x : result) {
+                    auto p = std::invoke(parser, input);
+                    if (!p) {
+                        return p.error();
+                    }
                     input = p->second;
-                    x = p->first;
-                } else {
-                    return failure;
+                    x = std::move(p->first);
                 }
+                return success(std::move(result), input);
             }
-            return success(result, input);
-        };
+        });
     }
 
-    auto trim(AnyParser auto parser) -> SameParser<decltype(parser)> auto {
-        return [parser](std::string_view input) -> ParserResult<decltype(parser)> {
-            input.remove_prefix(std::min(input.find_first_not_of("\n\t "), input.size()));
-            input.remove_suffix(std::min(input.size() - (input.find_last_not_of("\n\t ") + 1), input.size()));
-            return std::invoke(parser, input);
-        };
+    // combinators returning SameParser name their parser's type, as GCC 12 crashes hashing a
+    // SameParser<decltype(parser)> return constraint once two of them are instantiated in one translation unit
+    template <AnyParser Parser>
+    auto trim(Parser parser, CharClass whitespace = char_classes::whitespace) -> SameParser<Parser> auto {
+        return recognizable([parser, whitespace](std::string_view input, auto mode) -> ModeResult<decltype(mode), ParserValueType<Parser>> {
+            // the trailing whitespace runs to the end of input
+            reached_end(input);
+            input.remove_prefix(simd::prefix_length(input, whitespace));
+            input.remove_suffix(simd::suffix_length(input, whitespace));
+            return run(mode, parser, input);
+        });
+    }
+
+    // like trim, but only skips leading whitespace, leaving the rest of the input for whatever follows
+    template <AnyParser Parser>
+    auto trim_left(Parser parser, CharClass whitespace = char_classes::whitespace) -> SameParser<Parser> auto {
+        return recognizable([parser, whitespace](std::string_view input, auto mode) -> ModeResult<decltype(mode), ParserValueType<Parser>> {
+            std::size_t length = simd::prefix_length(input, whitespace);
+            if (length == input.size()) {
+                reached_end(input);
+            }
+            input.remove_prefix(length);
+            return run(mode, parser, input);
+        });
     }
 
     namespace {
-        auto choice_helper(std::string_view input, AnyParser auto parser, AnyParser auto... parsers)
-        -> Result<std::common_type_t<ParserValueType<decltype(parser)>, ParserValueType<decltype(parsers)>...>>
-        {
-            if (auto result = std::invoke(parser, input)) {
+        // the errors of the alternatives that failed so far, each living in the frame that tried it
+        struct Failed {
+            const Error& error;
+            const Failed* previous;
+        };
+
+        inline auto merged_error(const Failed* failed) -> Error {
+            Error error;
+            for (const Failed* f = failed; f != nullptr; f = f->previous) {
+                error.merge(f->error);
+            }
+            return error;
+        }
+
+        // the errors are only merged once the last alternative fails too, a success never pays for it
+        template <typename T>
+        auto choice_helper(std::string_view input, auto mode, const Failed* failed, const AnyParser auto& parser, const AnyParser auto&... parsers) -> Result<T> {
+            auto result = run(mode, parser, input);
+            if (result || result.error().fatal) {
                 return result;
             }
 
+            Failed here{result.error(), failed};
             if constexpr (sizeof...(parsers) == 0) {
-                return failure;
+                return merged_error(&here);
+            } else {
+                return choice_helper<T>(input, mode, &here, parsers...);
+            }
+        }
+
+        // the smallest unsigned type with a bit per alternative
+        template <std::size_t Count>
+        using AlternativeMask = std::conditional_t<Count <= 8, std::uint8_t,
+            std::conditional_t<Count <= 16, std::uint16_t,
+            std::conditional_t<Count <= 32, std::uint32_t, std::uint64_t>>>;
+
+        // for every byte, the alternatives whose first set has it, bit i standing for the i-th alternative
+        template <typename Mask>
+        auto dispatch_table(const AnyParser auto&... parsers) -> std::array<Mask, 256> {
+            std::array<Mask, 256> table{};
+            std::size_t i = 0;
+            auto add = [&table, &i](const CharClass& first_set) {
+                for (std::size_t byte = 0; byte < table.size(); ++byte) {
+                    if (first_set.contains(static_cast<char>(byte))) {
+                        table[byte] = static_cast<Mask>(table[byte] | Mask{1} << i);
+                    }
+                }
+                ++i;
+            };
+            (add(first_set_of(parsers)), ...);
+            return table;
+        }
+
+        template <typename T, typename Mask>
+        auto choice_candidates(std::string_view input, auto mode, Mask candidates, const Failed* failed, const AnyParser auto& parser, const AnyParser auto&... parsers) -> Result<T>;
+
+        // the candidates after the one just tried
+        template <typename T, typename Mask>
+        auto choice_next_candidates(std::string_view input, auto mode, Mask candidates, const Failed* failed, const AnyParser auto&... parsers) -> Result<T> {
+            candidates = static_cast<Mask>(candidates >> 1u);
+            if constexpr (sizeof...(parsers) == 0) {
+                return merged_error(failed);
+            } else {
+                if (candidates == 0) {
+                    return merged_error(failed);
+                }
+                return choice_candidates<T>(input, mode, candidates, failed, parsers...);
+            }
+        }
+
+        // tries the alternatives with a bit in candidates, in order, up to the first success. the failure merges their
+        // errors with the ones already in failed
+        template <typename T, typename Mask>
+        auto choice_candidates(std::string_view input, auto mode, Mask candidates, const Failed* failed, const AnyParser auto& parser, const AnyParser auto&... parsers) -> Result<T> {
+            if (candidates & 1u) {
+                auto result = run(mode, parser, input);
+                if (result || result.error().fatal) {
+                    return result;
+                }
+                Failed here{result.error(), failed};
+                return choice_next_candidates<T>(input, mode, candidates, &here, parsers...);
+            }
+            return choice_next_candidates<T>(input, mode, candidates, failed, parsers...);
+        }
+
+        // choice jumps on the first byte of the input straight to the alternatives whose first set has it, once at
+        // least one alternative tells its first set and there are few enough for a Mask to hold
+        template <typename T>
+        auto choice_parser(AnyParser auto... parsers) {
+            constexpr bool dispatch = (HasFirstSet<decltype(parsers)> || ...) && sizeof...(parsers) > 1 && sizeof...(parsers) <= 64;
+            if constexpr (dispatch) {
+                using Mask = AlternativeMask<sizeof...(parsers)>;
+                return recognizable([table = dispatch_table<Mask>(parsers...), parsers...](std::string_view input, auto mode) -> ModeResult<decltype(mode), T> {
+                    using Value = ModeResult<decltype(mode), T>::value_type::first_type;
+                    if (input.empty()) {
+                        return choice_helper<Value>(input, mode, nullptr, parsers...);
+                    }
+                    Mask candidates = table[static_cast<unsigned char>(input.front())];
+                    auto result = choice_candidates<Value>(input, mode, candidates, nullptr, parsers...);
+                    if (result) {
+                        return result;
+                    }
+                    const char* position = result.error().position;
+                    if (result.error().fatal || (position != nullptr && position > input.data())) {
+                        return result;
+                    }
+                    // every other alternative fails right at the start of input, and is only tried for the
+                    // expectation it adds there. parsing the candidates again would make a choice nesting in itself
+                    // take exponential time
+                    Failed failed{result.error(), nullptr};
+                    return choice_candidates<Value>(input, mode, static_cast<Mask>(~candidates), &failed, parsers...);
+                });
             } else {
-                return choice_helper(input, parsers...);
+                return recognizable([parsers...](std::string_view input, auto mode) -> ModeResult<decltype(mode), T> {
+                    using Value = ModeResult<decltype(mode), T>::value_type::first_type;
+                    return choice_helper<Value>(input, mode, nullptr, parsers...);
+                });
             }
         }
     }
 
     auto choice(AnyParser auto... parsers) -> Parser<std::common_type_t<ParserValueType<decltype(parsers)>...>> auto {
-        return [parsers...](std::string_view input) {
-            return choice_helper(input, parsers...);
-        };
+        using T = std::common_type_t<ParserValueType<decltype(parsers)>...>;
+        auto parser = choice_parser<T>(parsers...);
+        if constexpr ((HasFirstSet<decltype(parsers)> && ...)) {
+            return with_first_set(std::move(parser), (first_set_of(parsers) | ...));
+        } else {
+            return parser;
+        }
     }
 
-    auto many0_to_many1(AnyParser auto parser) -> SameParser<decltype(parser)> auto {
-        return [parser](std::string_view input) -> ParserResult<decltype(parser)> {
+    // only a parser, it needs the values it checks, so recognizing it parses
+    template <AnyParser Parser>
+    auto many0_to_many1(Parser parser) -> SameParser<Parser> auto {
+        return [parser](std::string_view input) -> ParserResult<Parser> {
             auto result = std::invoke(parser, input);
             if (result && result.value().first.empty()) {
-                return failure;
+                return failure_at(input);
             }
 
             return result;
         };
     }
 
-    auto many0(AnyParser auto parser) -> Parser<std::vector<ParserValueType<decltype(parser)>>> auto {
-        using Parser = decltype(parser);
-        return [parser](std::string_view input) -> Result<std::vector<ParserValueType<Parser>>> {
+    // what a repetition can collect its values of type T into instead of a std::vector: a container with push_back,
+    // like an InlineVector or a std::deque, or an output iterator, like a std::back_inserter into a vector reserved
+    // once and reused across parses
+    template <typename S, typename T>
+    concept Sink = std::copy_constructible<S> &&
+        (std::output_iterator<S, T> || requires(S& sink, T&& value) { sink.push_back(std::move(value)); });
+
+    namespace {
+        // the repetition loops fill whichever sink they are handed, so the std::vector, std::pmr::vector and Sink
+        // flavours of each combinator share one implementation. when recognizing they are handed an Ignored, which
+        // takes every Ignored value and keeps none
+        template <typename Vector>
+        auto values(Parsing, auto&&... args) -> Vector {
+            return Vector(std::forward<decltype(args)>(args)...);
+        }
+
+        template <typename Vector>
+        auto values(Recognizing, auto&&...) -> Ignored {
+            return Ignored();
+        }
+
+        template <typename Vector, typename T>
+        void add(Vector& result, T&& value) {
+            if constexpr (std::output_iterator<Vector, T>) {
+                *result++ = std::forward<T>(value);
+            } else {
+                result.push_back(std::forward<T>(value));
+            }
+        }
+
+        inline void add(Ignored&, Ignored) {}
+
+        template <typename Vector>
+        auto many0_helper(std::string_view input, auto mode, AnyParser auto parser, Vector result) -> Result<Vector> {
             std::string_view rest = input;
-            std::vector<ParserValueType<Parser>> result;
-            while (auto r = std::invoke(parser, rest)) {
-                result.push_back(r->first);
+            while (true) {
+                auto r = run(mode, parser, rest);
+                if (!r) {
+                    if (r.error().fatal) {
+                        return r.error();
+                    }
+                    break;
+                }
+                add(result, std::move(r->first));
                 rest = r->second;
             }
-            return success(result, rest);
-        };
+            return success(std::move(result), rest);
+        }
+
+        template <typename Vector>
+        auto many1_helper(std::string_view input, auto mode, AnyParser auto parser, Vector result) -> Result<Vector> {
+            auto first = run(mode, parser, input);
+            if (!first) {
+                return first.error();
+            }
+            add(result, std::move(first->first));
+            return many0_helper(first->second, mode, parser, std::move(result));
+        }
+
+        // many_seperated_by0 where at_least_one is false, many_seperated_by1 where it is true
+        template <typename Vector>
+        auto many_seperated_helper(std::string_view input, auto mode, AnyParser auto parser, AnyParser auto seperator, Vector result, bool at_least_one) -> Result<Vector> {
+            auto first = run(mode, parser, input);
+            if (!first) {
+                if (at_least_one || first.error().fatal) {
+                    return first.error();
+                }
+                return success(std::move(result), input);
+            }
+            add(result, std::move(first->first));
+            std::string_view rest = first->second;
+
+            while (true) {
+                auto s = skip(seperator, rest);
+                if (!s) {
+                    if (s.error().fatal) {
+                        return s.error();
+                    }
+                    break;
+                }
+                auto r = run(mode, parser, s->second);
+                if (!r) {
+                    if (r.error().fatal) {
+                        return r.error();
+                    }
+                    break;
+                }
+                add(result, std::move(r->first));
+                rest = r->second;
+            }
+            return success(std::move(result), rest);
+        }
+
+        template <typename Vector>
+        auto many_split_by0_helper(std::string_view input, auto mode, AnyParser auto parser, std::string_view seperator, Vector result) -> Result<Vector> {
+            // the last segment runs to the end of input
+            reached_end(input);
+            if (seperator.size() == 1) {
+                // single character seperators, the common case of newlines, can use the vectorized scanner
+                std::size_t begin = 0;
+                while (true) {
+                    std::string_view rest = input.substr(begin);
+                    std::size_t end = simd::find(rest, seperator[0]);
+                    auto r = run(mode, parser, rest.substr(0, end));
+                    if (!r) {
+                        return r.error();
+                    }
+                    if (!r->second.empty()) {
+                        return failure_at(r->second, seperator);
+                    }
+                    add(result, std::move(r->first));
+                    if (end == rest.size()) {
+                        break;
+                    }
+                    begin += end + 1;
+                }
+                return success(std::move(result), std::string_view());
+            }
+
+            auto lines = input | std::views::split(seperator);
+            auto parse_segment = [&](std::string_view segment) -> std::optional<Error> {
+                auto r = run(mode, parser, segment);
+                if (!r) {
+                    return r.error();
+                }
+                if (!r->second.empty()) {
+                    return failure_at(r->second, seperator);
+                }
+                add(result, std::move(r->first));
+                return std::nullopt;
+            };
+            if (lines.empty()) {
+                if (auto error = parse_segment(input)) {
+                    return *error;
+                }
+            } else {
+                for (auto line : lines) {
+                    if (auto error = parse_segment(std::string_view(line.begin(), line.end()))) {
+                        return *error;
+                    }
+                }
+            }
+            return success(std::move(result), std::string_view());
+        }
+
+        // whether the end of seperator can be the start of another occurrence, like "aa" in "aaa". such a seperator
+        // found from the middle of the input might not be one that splitting from the start would have cut at
+        inline auto self_overlapping(std::string_view seperator) -> bool {
+            for (std::size_t n = 1; n < seperator.size(); ++n) {
+                if (seperator.starts_with(seperator.substr(seperator.size() - n))) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // cuts input at the first seperator after every chunk_size bytes, dropping the seperators cut at, so splitting
+        // each chunk gives the same segments, in the same order, as splitting all of input
+        inline auto split_chunks(std::string_view input, std::string_view seperator, std::size_t chunk_size) -> std::vector<std::string_view> {
+            std::vector<std::string_view> chunks;
+            std::size_t begin = 0;
+            while (input.size() - begin > chunk_size) {
+                std::size_t cut = seperator.size() == 1
+                    ? begin + chunk_size + simd::find(input.substr(begin + chunk_size), seperator[0])
+                    : input.find(seperator, begin + chunk_size);
+                if (cut >= input.size()) {
+                    break;
+                }
+                chunks.push_back(input.substr(begin, cut - begin));
+                begin = cut + seperator.size();
+            }
+            chunks.push_back(input.substr(begin));
+            return chunks;
+        }
     }
 
-    auto many1(AnyParser auto parser) -> Parser<std::vector<ParserValueType<decltype(parser)>>> auto {
-        return many0_to_many1(many0(parser));
+    // the repetitions name their parser type for the same GCC 12 crash as trim, hit once many0 and many_seperated_by0
+    // are both instantiated in one translation unit
+    template <AnyParser Parser>
+    auto many0(Parser parser) -> ::pc::Parser<std::vector<ParserValueType<Parser>>> auto {
+        using Vector = std::vector<ParserValueType<Parser>>;
+        return recognizable([parser](std::string_view input, auto mode) -> ModeResult<decltype(mode), Vector> {
+            return many0_helper(input, mode, parser, values<Vector>(mode));
+        });
     }
 
-    auto many_seperated_by0(AnyParser auto parser, AnyParser auto seperator) -> Parser<std::vector<ParserValueType<decltype(parser)>>> auto {
-        using Parser = decltype(parser);
-        return [parser, seperator](std::string_view input) -> Result<std::vector<ParserValueType<Parser>>> {
-            std::vector<ParserValueType<Parser>> result;
-            std::string_view rest = input;
-            if (auto r = std::invoke(parser, rest)) {
-                result.push_back(r->first);
-                rest = r->second;
+    // like many0, but the vector allocates from resource, e.g. a pc::Arena scoped to the parse
+    template <AnyParser Parser>
+    auto many0(Parser parser, std::pmr::memory_resource* resource) -> ::pc::Parser<std::pmr::vector<ParserValueType<Parser>>> auto {
+        using Vector = std::pmr::vector<ParserValueType<Parser>>;
+        return recognizable([parser, resource](std::string_view input, auto mode) -> ModeResult<decltype(mode), Vector> {
+            return many0_helper(input, mode, parser, values<Vector>(mode, resource));
+        });
+    }
+
+    // like many0, but collecting into a copy of sink, see Sink. the value is the filled container, or the output
+    // iterator past the last value written
+    template <AnyParser Parser, Sink<ParserValueType<Parser>> S>
+    auto many0(Parser parser, S sink) -> ::pc::Parser<S> auto {
+        return recognizable([parser, sink](std::string_view input, auto mode) -> ModeResult<decltype(mode), S> {
+            return many0_helper(input, mode, parser, values<S>(mode, sink));
+        });
+    }
+
+    template <AnyParser Parser>
+    auto many1(Parser parser) -> ::pc::Parser<std::vector<ParserValueType<Parser>>> auto {
+        using Vector = std::vector<ParserValueType<Parser>>;
+        return recognizable([parser](std::string_view input, auto mode) -> ModeResult<decltype(mode), Vector> {
+            return many1_helper(input, mode, parser, values<Vector>(mode));
+        });
+    }
+
+    template <AnyParser Parser>
+    auto many1(Parser parser, std::pmr::memory_resource* resource) -> ::pc::Parser<std::pmr::vector<ParserValueType<Parser>>> auto {
+        using Vector = std::pmr::vector<ParserValueType<Parser>>;
+        return recognizable([parser, resource](std::string_view input, auto mode) -> ModeResult<decltype(mode), Vector> {
+            return many1_helper(input, mode, parser, values<Vector>(mode, resource));
+        });
+    }
+
+    template <AnyParser Parser, Sink<ParserValueType<Parser>> S>
+    auto many1(Parser parser, S sink) -> ::pc::Parser<S> auto {
+        return recognizable([parser, sink](std::string_view input, auto mode) -> ModeResult<decltype(mode), S> {
+            return many1_helper(input, mode, parser, values<S>(mode, sink));
+        });
+    }
+
+    template <AnyParser Parser>
+    auto many_seperated_by0(Parser parser, AnyParser auto seperator) -> ::pc::Parser<std::vector<ParserValueType<Parser>>> auto {
+        using Vector = std::vector<ParserValueType<Parser>>;
+        return recognizable([parser, seperator](std::string_view input, auto mode) -> ModeResult<decltype(mode), Vector> {
+            return many_seperated_helper(input, mode, parser, seperator, values<Vector>(mode), false);
+        });
+    }
+
+    template <AnyParser Parser>
+    auto many_seperated_by0(Parser parser, AnyParser auto seperator, std::pmr::memory_resource* resource)
+    -> ::pc::Parser<std::pmr::vector<ParserValueType<Parser>>> auto {
+        using Vector = std::pmr::vector<ParserValueType<Parser>>;
+        return recognizable([parser, seperator, resource](std::string_view input, auto mode) -> ModeResult<decltype(mode), Vector> {
+            return many_seperated_helper(input, mode, parser, seperator, values<Vector>(mode, resource), false);
+        });
+    }
+
+    template <AnyParser Parser, Sink<ParserValueType<Parser>> S>
+    auto many_seperated_by0(Parser parser, AnyParser auto seperator, S sink) -> ::pc::Parser<S> auto {
+        return recognizable([parser, seperator, sink](std::string_view input, auto mode) -> ModeResult<decltype(mode), S> {
+            return many_seperated_helper(input, mode, parser, seperator, values<S>(mode, sink), false);
+        });
+    }
+
+    template <AnyParser Parser>
+    auto many_seperated_by1(Parser parser, AnyParser auto seperator) -> ::pc::Parser<std::vector<ParserValueType<Parser>>> auto {
+        using Vector = std::vector<ParserValueType<Parser>>;
+        return recognizable([parser, seperator](std::string_view input, auto mode) -> ModeResult<decltype(mode), Vector> {
+            return many_seperated_helper(input, mode, parser, seperator, values<Vector>(mode), true);
+        });
+    }
+
+    template <AnyParser Parser>
+    auto many_seperated_by1(Parser parser, AnyParser auto seperator, std::pmr::memory_resource* resource)
+    -> ::pc::Parser<std::pmr::vector<ParserValueType<Parser>>> auto {
+        using Vector = std::pmr::vector<ParserValueType<Parser>>;
+        return recognizable([parser, seperator, resource](std::string_view input, auto mode) -> ModeResult<decltype(mode), Vector> {
+            return many_seperated_helper(input, mode, parser, seperator, values<Vector>(mode, resource), true);
+        });
+    }
+
+    template <AnyParser Parser, Sink<ParserValueType<Parser>> S>
+    auto many_seperated_by1(Parser parser, AnyParser auto seperator, S sink) -> ::pc::Parser<S> auto {
+        return recognizable([parser, seperator, sink](std::string_view input, auto mode) -> ModeResult<decltype(mode), S> {
+            return many_seperated_helper(input, mode, parser, seperator, values<S>(mode, sink), true);
+        });
+    }
+
+    template <AnyParser Parser>
+    auto many_split_by0(Parser parser, std::string_view seperator) -> ::pc::Parser<std::vector<ParserValueType<Parser>>> auto {
+        using Vector = std::vector<ParserValueType<Parser>>;
+        return recognizable([parser, seperator](std::string_view input, auto mode) -> ModeResult<decltype(mode), Vector> {
+            return many_split_by0_helper(input, mode, parser, seperator, values<Vector>(mode));
+        });
+    }
+
+    template <AnyParser Parser>
+    auto many_split_by0(Parser parser, std::string_view seperator, std::pmr::memory_resource* resource)
+    -> ::pc::Parser<std::pmr::vector<ParserValueType<Parser>>> auto {
+        using Vector = std::pmr::vector<ParserValueType<Parser>>;
+        return recognizable([parser, seperator, resource](std::string_view input, auto mode) -> ModeResult<decltype(mode), Vector> {
+            return many_split_by0_helper(input, mode, parser, seperator, values<Vector>(mode, resource));
+        });
+    }
+
+    template <AnyParser Parser, Sink<ParserValueType<Parser>> S>
+    auto many_split_by0(Parser parser, std::string_view seperator, S sink) -> ::pc::Parser<S> auto {
+        return recognizable([parser, seperator, sink](std::string_view input, auto mode) -> ModeResult<decltype(mode), S> {
+            return many_split_by0_helper(input, mode, parser, seperator, values<S>(mode, sink));
+        });
+    }
+
+    // splitting gives at least one segment, so a successful many_split_by0 already has a value
+    template <AnyParser Parser>
+    auto many_split_by1(Parser parser, std::string_view seperator) -> ::pc::Parser<std::vector<ParserValueType<Parser>>> auto {
+        return many_split_by0(parser, seperator);
+    }
+
+    template <AnyParser Parser>
+    auto many_split_by1(Parser parser, std::string_view seperator, std::pmr::memory_resource* resource)
+    -> ::pc::Parser<std::pmr::vector<ParserValueType<Parser>>> auto {
+        return many_split_by0(parser, seperator, resource);
+    }
+
+    template <AnyParser Parser, Sink<ParserValueType<Parser>> S>
+    auto many_split_by1(Parser parser, std::string_view seperator, S sink) -> ::pc::Parser<S> auto {
+        return many_split_by0(parser, seperator, sink);
+    }
+
+    // like many_split_by0, but the input is cut into seperator aligned chunks of at least min_chunk_size bytes which are
+    // parsed on pool. the values keep their input order and the first failing segment fails the whole parse. parser is
+    // called from several threads at once, and pool has to outlive the returned parser
+    auto par_many_split_by0(AnyParser auto parser, std::string_view seperator, ThreadPool& pool, std::size_t min_chunk_size = 64 * 1024)
+    -> Parser<std::vector<ParserValueType<decltype(parser)>>> auto {
+        using Vector = std::vector<ParserValueType<decltype(parser)>>;
+        return recognizable([parser, seperator, min_chunk_size, threads = &pool](std::string_view input, auto mode) -> ModeResult<decltype(mode), Vector> {
+            using Values = decltype(values<Vector>(mode));
+            reached_end(input);
+            if (seperator.empty() || self_overlapping(seperator)) {
+                return many_split_by0_helper(input, mode, parser, seperator, values<Vector>(mode));
+            }
+
+            // a few chunks per thread, so stealing can even out chunks that take longer than others
+            std::size_t chunk_size = std::max(min_chunk_size, input.size() / (threads->size() * 4) + 1);
+            std::vector<std::string_view> chunks = split_chunks(input, seperator, chunk_size);
+            if (chunks.size() == 1) {
+                return many_split_by0_helper(input, mode, parser, seperator, values<Vector>(mode));
+            }
+
+            std::vector<Result<Values>> results(chunks.size());
+            std::atomic<std::size_t> first_failed = chunks.size();
+            threads->parallel_for(chunks.size(), [&](std::size_t i) {
+                // the parse is lost once a chunk fails, only the chunks before it still matter, for reporting the same
+                // failure a sequential parse would
+                if (i > first_failed.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                results[i] = many_split_by0_helper(chunks[i], mode, parser, seperator, values<Vector>(mode));
+                std::size_t failed = first_failed.load(std::memory_order_relaxed);
+                while (!results[i] && i < failed && !first_failed.compare_exchange_weak(failed, i)) {
+                }
+            });
+            if (first_failed < chunks.size()) {
+                return results[first_failed].error();
+            }
+
+            if constexpr (recognizing<decltype(mode)>) {
+                return success(Ignored(), std::string_view());
+            } else {
+                std::size_t count = 0;
+                for (const Result<Vector>& result : results) {
+                    count += result->first.size();
+                }
+                Vector all_values;
+                all_values.reserve(count);
+                for (Result<Vector>& result : results) {
+                    std::ranges::move(result->first, std::back_inserter(all_values));
+                }
+                return success(std::move(all_values), std::string_view());
             }
+        });
+    }
 
-            while (auto s = std::invoke(seperator, rest)) {
-                if (auto r = std::invoke(parser, s->second)) {
-                    result.push_back(r->first);
-                    rest = r->second;
-                } else {
+    auto par_many_split_by1(AnyParser auto parser, std::string_view seperator, ThreadPool& pool, std::size_t min_chunk_size = 64 * 1024)
+    -> Parser<std::vector<ParserValueType<decltype(parser)>>> auto {
+        return par_many_split_by0(parser, seperator, pool, min_chunk_size);
+    }
+
+    namespace {
+        // folds the values of parser into accumulator for as long as it matches, the loop of many0_fold and many1_fold
+        template <typename Accumulator>
+        auto fold_helper(std::string_view input, const AnyParser auto& parser, Accumulator accumulator, const auto& step) -> Result<Accumulator> {
+            while (true) {
+                auto r = std::invoke(parser, input);
+                if (!r) {
+                    if (r.error().fatal) {
+                        return r.error();
+                    }
                     break;
                 }
+                accumulator = std::invoke(step, std::move(accumulator), std::move(r->first));
+                input = r->second;
             }
-            return success(result, rest);
-        };
+            return success(std::move(accumulator), input);
+        }
+
+        // the loop of the seperated folds, past their first value
+        template <typename Accumulator>
+        auto fold_seperated_helper(std::string_view input, const AnyParser auto& parser, const AnyParser auto& seperator, Accumulator accumulator, const auto& step) -> Result<Accumulator> {
+            while (true) {
+                auto s = skip(seperator, input);
+                if (!s) {
+                    if (s.error().fatal) {
+                        return s.error();
+                    }
+                    break;
+                }
+                auto r = std::invoke(parser, s->second);
+                if (!r) {
+                    if (r.error().fatal) {
+                        return r.error();
+                    }
+                    break;
+                }
+                accumulator = std::invoke(step, std::move(accumulator), std::move(r->first));
+                input = r->second;
+            }
+            return success(std::move(accumulator), input);
+        }
     }
 
-    auto many_seperated_by1(AnyParser auto parser, AnyParser auto seperator) -> Parser<std::vector<ParserValueType<decltype(parser)>>> auto {
-        return many0_to_many1(many_seperated_by0(parser, seperator));
+    // like many0 followed by a fold, but each value is folded into the accumulator as soon as it is parsed, so no vector
+    // is ever built. every parse starts from a copy of init, step is called as step(accumulator, value)
+    auto many0_fold(AnyParser auto parser, auto init, std::invocable<decltype(init), ParserValueType<decltype(parser)>> auto step)
+    -> Parser<decltype(init)> auto {
+        using Accumulator = decltype(init);
+        return recognizable([parser, init, step](std::string_view input, auto mode) -> ModeResult<decltype(mode), Accumulator> {
+            if constexpr (recognizing<decltype(mode)>) {
+                return many0_helper(input, mode, parser, Ignored());
+            } else {
+                return fold_helper<Accumulator>(input, parser, init, step);
+            }
+        });
     }
 
-    auto many_split_by0(AnyParser auto parser, std::string_view seperator) -> Parser<std::vector<ParserValueType<decltype(parser)>>> auto {
-        using Parser = decltype(parser);
-        using ValueType = ParserValueType<Parser>;
-        return [parser, seperator](std::string_view input) -> Result<std::vector<ValueType>> {
-            std::vector<ValueType> result;
-            auto lines = input | std::views::split(seperator);
-            if (lines.empty()) {
-                if (auto r = std::invoke(parser, input); r && r->second.empty()) {
-                    result.push_back(r->first);
-                } else {
-                    return failure;
+    auto many1_fold(AnyParser auto parser, auto init, std::invocable<decltype(init), ParserValueType<decltype(parser)>> auto step)
+    -> Parser<decltype(init)> auto {
+        using Accumulator = decltype(init);
+        return recognizable([parser, init, step](std::string_view input, auto mode) -> ModeResult<decltype(mode), Accumulator> {
+            if constexpr (recognizing<decltype(mode)>) {
+                return many1_helper(input, mode, parser, Ignored());
+            } else {
+                auto first = std::invoke(parser, input);
+                if (!first) {
+                    return first.error();
                 }
+                return fold_helper<Accumulator>(first->second, parser, std::invoke(step, init, std::move(first->first)), step);
+            }
+        });
+    }
+
+    // like many_seperated_by0 followed by a fold, see many0_fold
+    auto many_seperated_by0_fold(AnyParser auto parser, AnyParser auto seperator, auto init,
+        std::invocable<decltype(init), ParserValueType<decltype(parser)>> auto step) -> Parser<decltype(init)> auto {
+        using Accumulator = decltype(init);
+        return recognizable([parser, seperator, init, step](std::string_view input, auto mode) -> ModeResult<decltype(mode), Accumulator> {
+            if constexpr (recognizing<decltype(mode)>) {
+                return many_seperated_helper(input, mode, parser, seperator, Ignored(), false);
             } else {
-                for (auto line : lines) {
-                    if (auto r = std::invoke(parser, std::string_view(line.begin(), line.end())); r && r->second.empty()) {
-                        result.push_back(r->first);
-                    } else {
-                        return failure;
+                auto first = std::invoke(parser, input);
+                if (!first) {
+                    if (first.error().fatal) {
+                        return first.error();
                     }
+                    return success(init, input);
                 }
+                return fold_seperated_helper<Accumulator>(first->second, parser, seperator, std::invoke(step, init, std::move(first->first)), step);
             }
-            return success(result, std::string_view());
-        };
+        });
     }
 
-    auto many_split_by1(AnyParser auto parser, std::string_view seperator) -> Parser<std::vector<ParserValueType<decltype(parser)>>> auto {
-        return many0_to_many1(many_split_by0(parser, seperator));
+    auto many_seperated_by1_fold(AnyParser auto parser, AnyParser auto seperator, auto init,
+        std::invocable<decltype(init), ParserValueType<decltype(parser)>> auto step) -> Parser<decltype(init)> auto {
+        using Accumulator = decltype(init);
+        return recognizable([parser, seperator, init, step](std::string_view input, auto mode) -> ModeResult<decltype(mode), Accumulator> {
+            if constexpr (recognizing<decltype(mode)>) {
+                return many_seperated_helper(input, mode, parser, seperator, Ignored(), true);
+            } else {
+                auto first = std::invoke(parser, input);
+                if (!first) {
+                    return first.error();
+                }
+                return fold_seperated_helper<Accumulator>(first->second, parser, seperator, std::invoke(step, init, std::move(first->first)), step);
+            }
+        });
     }
 
     auto pair(AnyParser auto lhs, AnyParser auto rhs)
     -> Parser<std::pair<ParserValueType<decltype(lhs)>, ParserValueType<decltype(rhs)>>> auto {
         using Lhs = decltype(lhs);
         using Rhs = decltype(rhs);
-        return [lhs, rhs](std::string_view input) -> Result<std::pair<ParserValueType<Lhs>, ParserValueType<Rhs>>> {
-            if (auto l = std::invoke(lhs, input)) {
-                if (auto r = std::invoke(rhs, l->second)) {
-                    return success(std::pair{l->first, r->first}, r->second);
-                }
+        using Pair = std::pair<ParserValueType<Lhs>, ParserValueType<Rhs>>;
+        return with_first_set_of(recognizable([lhs, rhs](std::string_view input, auto mode) -> ModeResult<decltype(mode), Pair> {
+            auto l = run(mode, lhs, input);
+            if (!l) {
+                return l.error();
             }
-            return failure;
-        };
+            auto r = run(mode, rhs, l->second);
+            if (!r) {
+                return r.error();
+            }
+            if constexpr (recognizing<decltype(mode)>) {
+                return r;
+            } else {
+                return success(std::pair{std::move(l->first), std::move(r->first)}, r->second);
+            }
+        }), lhs);
     }
 
     auto seperated_pair(AnyParser auto lhs, AnyParser auto sep, AnyParser auto rhs) -> Parser<std::pair<ParserValueType<decltype(lhs)>, ParserValueType<decltype(rhs)>>> auto {
         using Lhs = decltype(lhs);
         using Rhs = decltype(rhs);
-        return [lhs, rhs, sep](std::string_view input) -> Result<std::pair<ParserValueType<Lhs>, ParserValueType<Rhs>>> {
-            if (auto l = std::invoke(lhs, input)) {
-                if (auto s = std::invoke(sep, l->second)) {
-                    if (auto r = std::invoke(rhs, s->second)) {
-                        return success(std::pair{l->first, r->first}, r->second);
-                    }
-                }
+        using Pair = std::pair<ParserValueType<Lhs>, ParserValueType<Rhs>>;
+        return with_first_set_of(recognizable([lhs, rhs, sep](std::string_view input, auto mode) -> ModeResult<decltype(mode), Pair> {
+            auto l = run(mode, lhs, input);
+            if (!l) {
+                return l.error();
             }
-            return failure;
-        };
+            auto s = skip(sep, l->second);
+            if (!s) {
+                return s.error();
+            }
+            auto r = run(mode, rhs, s->second);
+            if (!r) {
+                return r.error();
+            }
+            if constexpr (recognizing<decltype(mode)>) {
+                return r;
+            } else {
+                return success(std::pair{std::move(l->first), std::move(r->first)}, r->second);
+            }
+        }), lhs);
+    }
+
+    // parser, but with its value dropped, for the delimiters of a tuple, or the arguments of preceded, terminated and
+    // delimited that are only there to be matched. parser is only recognized, so where it is Recognizable its value is
+    // never even constructed
+    template <AnyParser Parser>
+    auto ignore(Parser parser) -> ::pc::Parser<Ignored> auto {
+        return with_first_set_of([parser](std::string_view input) -> Result<Ignored> {
+            return skip(parser, input);
+        }, parser);
     }
 
+    // the tuple of Ts without the Ignored ones
+    template <typename... Ts>
+    using SequenceTuple = decltype(std::tuple_cat(std::declval<std::conditional_t<std::is_same_v<Ts, Ignored>, std::tuple<>, std::tuple<Ts>>>()...));
+
     namespace {
-        auto tuple_helper(std::string_view input, AnyParser auto parser, AnyParser auto... rest) -> Result<std::tuple<ParserValueType<decltype(parser)>, ParserValueType<decltype(rest)>...>> {
-            if (auto result = std::invoke(parser, input)) {
-                auto x = std::make_tuple(result->first);
-                if constexpr(sizeof...(rest) == 0) {
-                    return success(x, result->second);
-                } else {
-                    auto xs = tuple_helper(result->second, rest...);
-                    if (xs.has_value()) {
-                        return success(std::tuple_cat(x, xs.value().first), xs.value().second);
-                    }
-                }
+        // parses one element after the other, each frame keeping its element's Result, then the last one constructs the
+        // tuple in place from all of them. build takes the values left to add and calls the build of the frame before
+        // with its own value in front, so every value is moved exactly once, straight into the tuple
+        template <typename Tuple>
+        auto sequence_helper(std::string_view input, const auto& build) -> Result<Tuple> {
+            return build(input);
+        }
+
+        template <typename Tuple>
+        auto sequence_helper(std::string_view input, const auto& build, const AnyParser auto& parser, const AnyParser auto&... rest) -> Result<Tuple> {
+            auto result = std::invoke(parser, input);
+            if (!result) {
+                return result.error();
+            }
+            if constexpr (std::is_same_v<ParserValueType<decltype(parser)>, Ignored>) {
+                return sequence_helper<Tuple>(result->second, build, rest...);
+            } else {
+                auto next = [&build, &result](std::string_view rest_of_input, auto&&... values) -> Result<Tuple> {
+                    return build(rest_of_input, std::move(result->first), std::forward<decltype(values)>(values)...);
+                };
+                return sequence_helper<Tuple>(result->second, next, rest...);
             }
+        }
+
+        template <typename Tuple>
+        auto sequence(std::string_view input, const AnyParser auto&... parsers) -> Result<Tuple> {
+            auto build = [](std::string_view rest_of_input, auto&&... values) -> Result<Tuple> {
+                return Result<Tuple>(std::in_place, std::piecewise_construct,
+                    std::forward_as_tuple(std::forward<decltype(values)>(values)...), std::forward_as_tuple(rest_of_input));
+            };
+            return sequence_helper<Tuple>(input, build, parsers...);
+        }
 
-            return failure;
+        inline auto skip_sequence(std::string_view input) -> Result<Ignored> {
+            return success(Ignored(), input);
+        }
+
+        auto skip_sequence(std::string_view input, const AnyParser auto& parser, const AnyParser auto&... rest) -> Result<Ignored> {
+            auto result = skip(parser, input);
+            if (!result) {
+                return result.error();
+            }
+            return skip_sequence(result->second, rest...);
         }
     }
 
-    auto tuple(AnyParser auto... parsers) -> Parser<std::tuple<ParserValueType<decltype(parsers)>...>> auto {
-        return [parsers...](std::string_view input) {
-            return tuple_helper(input, parsers...);
-        };
+    // the values of parsers one after the other, apart from the ignored ones
+    auto tuple(AnyParser auto... parsers) -> Parser<SequenceTuple<ParserValueType<decltype(parsers)>...>> auto {
+        using Tuple = SequenceTuple<ParserValueType<decltype(parsers)>...>;
+        auto parser = recognizable([parsers...](std::string_view input, auto mode) -> ModeResult<decltype(mode), Tuple> {
+            if constexpr (recognizing<decltype(mode)>) {
+                return skip_sequence(input, parsers...);
+            } else {
+                return sequence<Tuple>(input, parsers...);
+            }
+        });
+        return with_first_set_of(std::move(parser), std::get<0>(std::tie(parsers...)));
+    }
+
+    // the value of parser, once prefix matched before it
+    template <AnyParser Parser>
+    auto preceded(AnyParser auto prefix, Parser parser) -> SameParser<Parser> auto {
+        return with_first_set_of(recognizable([prefix, parser](std::string_view input, auto mode) -> ModeResult<decltype(mode), ParserValueType<Parser>> {
+            auto p = skip(prefix, input);
+            if (!p) {
+                return p.error();
+            }
+            return run(mode, parser, p->second);
+        }), prefix);
+    }
+
+    // the value of parser, once suffix matched after it
+    template <AnyParser Parser>
+    auto terminated(Parser parser, AnyParser auto suffix) -> SameParser<Parser> auto {
+        return with_first_set_of(recognizable([parser, suffix](std::string_view input, auto mode) -> ModeResult<decltype(mode), ParserValueType<Parser>> {
+            auto result = run(mode, parser, input);
+            if (!result) {
+                return result.error();
+            }
+            auto s = skip(suffix, result->second);
+            if (!s) {
+                return s.error();
+            }
+            return success(std::move(result->first), s->second);
+        }), parser);
+    }
+
+    // the value of parser, between open and close
+    template <AnyParser Parser>
+    auto delimited(AnyParser auto open, Parser parser, AnyParser auto close) -> SameParser<Parser> auto {
+        return preceded(open, terminated(parser, close));
     }
 
+    // recognizing a map only recognizes its parser, fn is never called
     auto map(AnyParser auto parser, std::invocable<ParserValueType<decltype(parser)>> auto fn) -> Parser<std::invoke_result_t<decltype(fn), ParserValueType<decltype(parser)>>> auto {
         using Parser = decltype(parser);
         using Fn = decltype(fn);
         using FnReturnType = std::invoke_result_t<Fn, ParserValueType<Parser>>;
-        return [parser, fn](std::string_view input) -> Result<FnReturnType> {
-            if (auto result = std::invoke(parser, input)) {
-                return success(std::invoke(fn, result->first), result->second);
+        return with_first_set_of(recognizable([parser, fn](std::string_view input, auto mode) -> ModeResult<decltype(mode), FnReturnType> {
+            if constexpr (recognizing<decltype(mode)>) {
+                return skip(parser, input);
+            } else {
+                auto result = std::invoke(parser, input);
+                if (!result) {
+                    return result.error();
+                }
+                return success(std::invoke(fn, std::move(result->first)), result->second);
             }
-            return failure;
-        };
+        }), parser);
     }
 
-    auto filter(AnyParser auto parser, std::predicate<ParserValueType<decltype(parser)>> auto predicate) -> SameParser<decltype(parser)> auto {
-        using Parser = decltype(parser);
-        return [parser, predicate](std::string_view input) -> ParserResult<Parser> {
-            if (auto result = std::invoke(parser, input)) {
-                if (predicate(result->first)) {
-                    return success(result->first, result->second);
-                }
+    // only a parser, it needs the values it checks, so recognizing it parses
+    template <AnyParser Parser>
+    auto filter(Parser parser, std::predicate<ParserValueType<Parser>> auto predicate) -> SameParser<Parser> auto {
+        return with_first_set_of([parser, predicate](std::string_view input) -> ParserResult<Parser> {
+            auto result = std::invoke(parser, input);
+            if (!result) {
+                return result.error();
             }
-            return failure;
-        };
+            if (!predicate(std::as_const(result->first))) {
+                return failure_at(input);
+            }
+            return success(std::move(result->first), result->second);
+        }, parser);
+    }
+
+    // the input parser consumes, as a slice of it, without constructing the values of parser or of any Recognizable
+    // parser it is built from. for validating input, or finding where a record ends, with the grammar that parses it
+    template <AnyParser Parser>
+    auto recognize(Parser parser) -> ::pc::Parser<std::string_view> auto {
+        return with_first_set_of(recognizable([parser](std::string_view input, auto mode) -> ModeResult<decltype(mode), std::string_view> {
+            auto result = skip(parser, input);
+            if (!result) {
+                return result.error();
+            }
+            if constexpr (recognizing<decltype(mode)>) {
+                return result;
+            } else {
+                return success(input.substr(0, input.size() - result->second.size()), result->second);
+            }
+        }), parser);
     }
 } // namespace pc::combinators
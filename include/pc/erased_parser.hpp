@@ -0,0 +1,178 @@
+#pragma once
+
+#include <pc/pc.hpp>
+#include <pc/char_class.hpp>
+#include <pc/first_set.hpp>
+#include <pc/recognizer.hpp>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace pc {
+    // #region types
+    // any parser of T behind one type, for storing parsers in containers, as members, or across translation units. a
+    // parser of up to Capacity bytes is stored inside the ErasedParser itself, larger ones on the heap, and every parse
+    // is a single indirect call. the first set and the recognizer of the parser are kept, so an ErasedParser still
+    // lets choice dispatch on it and recognize skip its values. a default constructed one fails on every input, as
+    // does one that was moved from
+    template <typename T, std::size_t Capacity = 64>
+    class ErasedParser {
+    public:
+        ErasedParser() : ErasedParser(Fails()) {}
+
+        template <typename P>
+            requires Parser<P, T> && (!std::same_as<std::remove_cvref_t<P>, ErasedParser>)
+        ErasedParser(P parser) : first_set_(first_set_of(parser)) {
+            using Model = ModelOf<P>;
+            Model::create(storage_.data(), std::move(parser));
+            parse_ = &Model::parse;
+            operations_ = &Model::operations;
+        }
+
+        ErasedParser(const ErasedParser& other)
+            : parse_(other.parse_), operations_(other.operations_), first_set_(other.first_set_) {
+            operations_->copy(other.storage_.data(), storage_.data());
+        }
+
+        ErasedParser(ErasedParser&& other) noexcept
+            : parse_(other.parse_), operations_(other.operations_), first_set_(other.first_set_) {
+            operations_->move(other.storage_.data(), storage_.data());
+            other.fail();
+        }
+
+        auto operator=(const ErasedParser& other) -> ErasedParser& {
+            if (this != &other) {
+                ErasedParser copy(other);
+                *this = std::move(copy);
+            }
+            return *this;
+        }
+
+        auto operator=(ErasedParser&& other) noexcept -> ErasedParser& {
+            if (this != &other) {
+                operations_->destroy(storage_.data());
+                parse_ = other.parse_;
+                operations_ = other.operations_;
+                first_set_ = other.first_set_;
+                operations_->move(other.storage_.data(), storage_.data());
+                other.fail();
+            }
+            return *this;
+        }
+
+        ~ErasedParser() {
+            operations_->destroy(storage_.data());
+        }
+
+        auto operator()(std::string_view input) const -> Result<T> {
+            return parse_(storage_.data(), input);
+        }
+
+        auto recognize(std::string_view input) const -> Result<Ignored> {
+            return operations_->recognize(storage_.data(), input);
+        }
+
+        // the first set of the parser, every byte where it has none
+        auto first_set() const -> const CharClass& {
+            return first_set_;
+        }
+
+    private:
+        using Storage = std::array<std::byte, Capacity>;
+
+        // the parser of a default constructed ErasedParser
+        struct Fails {
+            auto operator()(std::string_view input) const -> Result<T> {
+                return failure_at(input);
+            }
+        };
+
+        // what is done with a parser other than parsing, shared by all ErasedParsers of the same parser type
+        struct Operations {
+            void (*copy)(const std::byte* from, std::byte* to);
+            void (*move)(std::byte* from, std::byte* to) noexcept;
+            void (*destroy)(std::byte* storage) noexcept;
+            auto (*recognize)(const std::byte* storage, std::string_view input) -> Result<Ignored>;
+        };
+
+        // a parser of type P kept in the storage, or a pointer to it on the heap where it does not fit or could throw
+        // while moving
+        template <typename P>
+        struct ModelOf {
+            static constexpr bool is_inline = sizeof(P) <= Capacity && alignof(P) <= alignof(std::max_align_t) &&
+                std::is_nothrow_move_constructible_v<P>;
+
+            static auto get(const std::byte* storage) -> const P& {
+                if constexpr (is_inline) {
+                    return *std::launder(reinterpret_cast<const P*>(storage));
+                } else {
+                    return **std::launder(reinterpret_cast<P* const*>(storage));
+                }
+            }
+
+            static void create(std::byte* storage, P parser) {
+                if constexpr (is_inline) {
+                    ::new (static_cast<void*>(storage)) P(std::move(parser));
+                } else {
+                    ::new (static_cast<void*>(storage)) P*(new P(std::move(parser)));
+                }
+            }
+
+            static auto parse(const std::byte* storage, std::string_view input) -> Result<T> {
+                return std::invoke(get(storage), input);
+            }
+
+            static void copy(const std::byte* from, std::byte* to) {
+                create(to, get(from));
+            }
+
+            static void move(std::byte* from, std::byte* to) noexcept {
+                if constexpr (is_inline) {
+                    ::new (static_cast<void*>(to)) P(std::move(*std::launder(reinterpret_cast<P*>(from))));
+                } else {
+                    // the heap parser changes owner, leaving null behind for destroy
+                    P*& pointer = *std::launder(reinterpret_cast<P**>(from));
+                    ::new (static_cast<void*>(to)) P*(std::exchange(pointer, nullptr));
+                }
+            }
+
+            static void destroy(std::byte* storage) noexcept {
+                if constexpr (is_inline) {
+                    std::destroy_at(std::launder(reinterpret_cast<P*>(storage)));
+                } else {
+                    delete *std::launder(reinterpret_cast<P**>(storage));
+                }
+            }
+
+            static auto recognize(const std::byte* storage, std::string_view input) -> Result<Ignored> {
+                return skip(get(storage), input);
+            }
+
+            static constexpr Operations operations = {&copy, &move, &destroy, &recognize};
+        };
+
+        // destroys what is left of a parser that was moved away, which might not be callable any more, and fails on
+        // every input from then on
+        void fail() noexcept {
+            using Model = ModelOf<Fails>;
+            operations_->destroy(storage_.data());
+            ::new (static_cast<void*>(storage_.data())) Fails();
+            parse_ = &Model::parse;
+            operations_ = &Model::operations;
+            first_set_ = any_first_set;
+        }
+
+        alignas(std::max_align_t) Storage storage_;
+        // kept out of operations_, so a parse is one indirect call rather than a load of the table and then a call
+        auto (*parse_)(const std::byte* storage, std::string_view input) -> Result<T>;
+        const Operations* operations_;
+        CharClass first_set_;
+    };
+    // #endregion
+} // namespace pc
@@ -0,0 +1,245 @@
+#pragma once
+
+#include <pc/pc.hpp>
+#include <pc/char_class.hpp>
+#include <pc/first_set.hpp>
+#include <pc/inline_vector.hpp>
+#include <pc/recognizer.hpp>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace pc::combinators {
+    // #region types
+    enum class Associativity {
+        left,
+        right,
+    };
+
+    enum class Fixity {
+        prefix,
+        infix,
+        postfix,
+    };
+
+    // an operator of expression: where parser matches, fn combines the operands around it into one. higher precedences
+    // bind tighter, and operators of equal precedence group as the associativity of the later one says
+    template <typename P, typename F>
+    struct PrefixOperator {
+        static constexpr Fixity fixity = Fixity::prefix;
+
+        P parser;
+        int precedence;
+        F fn;
+    };
+
+    template <typename P, typename F>
+    struct InfixOperator {
+        static constexpr Fixity fixity = Fixity::infix;
+
+        P parser;
+        int precedence;
+        Associativity associativity;
+        F fn;
+    };
+
+    template <typename P, typename F>
+    struct PostfixOperator {
+        static constexpr Fixity fixity = Fixity::postfix;
+
+        P parser;
+        int precedence;
+        F fn;
+    };
+    // #endregion
+
+    // #region concepts
+    template <typename O>
+    concept Operator = requires(const O& op) {
+        { O::fixity } -> std::convertible_to<Fixity>;
+        { op.precedence } -> std::convertible_to<int>;
+        requires AnyParser<decltype(op.parser)>;
+    };
+    // #endregion
+
+    // #region helpers
+    // fn(operand) -> operand, e.g. negation
+    auto prefix(AnyParser auto parser, int precedence, auto fn) -> PrefixOperator<decltype(parser), decltype(fn)> {
+        return {std::move(parser), precedence, std::move(fn)};
+    }
+
+    // fn(lhs, rhs) -> operand, e.g. addition
+    auto infix(AnyParser auto parser, int precedence, Associativity associativity, auto fn)
+    -> InfixOperator<decltype(parser), decltype(fn)> {
+        return {std::move(parser), precedence, associativity, std::move(fn)};
+    }
+
+    // fn(operand) -> operand, e.g. a factorial
+    auto postfix(AnyParser auto parser, int precedence, auto fn) -> PostfixOperator<decltype(parser), decltype(fn)> {
+        return {std::move(parser), precedence, std::move(fn)};
+    }
+
+    namespace {
+        // an operator that was matched, as its index among the operators, and the input after it
+        struct OperatorMatch {
+            std::size_t index;
+            int precedence;
+            Associativity associativity;
+            std::string_view rest;
+        };
+
+        // an operator waiting on the stack of expression for its right operand to be complete
+        struct PendingOperator {
+            std::size_t index;
+            int precedence;
+        };
+
+        // the first of operators with fixity F that matches at the start of input, in the order they were given
+        template <Fixity F, typename Operators, std::size_t... I>
+        auto match_operator(const Operators& operators, std::string_view input, std::index_sequence<I...>) -> std::optional<OperatorMatch> {
+            std::optional<OperatorMatch> match;
+            auto try_operator = [&](std::size_t index, const auto& op) {
+                if constexpr (std::remove_cvref_t<decltype(op)>::fixity == F) {
+                    if (auto r = skip(op.parser, input)) {
+                        Associativity associativity = Associativity::left;
+                        if constexpr (F == Fixity::infix) {
+                            associativity = op.associativity;
+                        }
+                        match = OperatorMatch{index, op.precedence, associativity, r->second};
+                        return true;
+                    }
+                }
+                return false;
+            };
+            (try_operator(I, std::get<I>(operators)) || ...);
+            return match;
+        }
+
+        // applies operator index of operators to the operands at the top of the stack, one or two depending on its
+        // fixity, leaving its value in their place
+        template <typename Operators, typename Operands, std::size_t... I>
+        void apply_operator(const Operators& operators, std::size_t index, Operands& operands, std::index_sequence<I...>) {
+            auto apply = [&operands](const auto& op) {
+                if constexpr (std::remove_cvref_t<decltype(op)>::fixity == Fixity::infix) {
+                    auto rhs = std::move(operands.back());
+                    operands.pop_back();
+                    operands.back() = std::invoke(op.fn, std::move(operands.back()), std::move(rhs));
+                } else {
+                    operands.back() = std::invoke(op.fn, std::move(operands.back()));
+                }
+            };
+            ((I == index ? (apply(std::get<I>(operators)), true) : false) || ...);
+        }
+
+        // the first set of an expression: its primary, or one of its prefix operators
+        template <typename Operators, std::size_t... I>
+        auto expression_first_set(const AnyParser auto& primary, const Operators& operators, std::index_sequence<I...>) -> CharClass {
+            auto prefix_first_set = [](const auto& op) {
+                if constexpr (std::remove_cvref_t<decltype(op)>::fixity == Fixity::prefix) {
+                    return first_set_of(op.parser);
+                } else {
+                    return CharClass();
+                }
+            };
+            return (first_set_of(primary) | ... | prefix_first_set(std::get<I>(operators)));
+        }
+
+        // whether the first set of an expression is known, which needs the first sets of every parser it may start with
+        template <typename Primary, typename... Operators>
+        constexpr bool expression_has_first_set = HasFirstSet<Primary> &&
+            ((Operators::fixity != Fixity::prefix || HasFirstSet<decltype(Operators::parser)>) && ...);
+    }
+
+    // an expression of primary terms and the operators between, before and after them, parsed in one loop by precedence
+    // climbing rather than a grammar layer per precedence. the operands waiting for an operator of higher precedence
+    // and the operators waiting for their right operand are kept on two explicit stacks, inline for expressions of up
+    // to 8 pending ones, so neither the nesting of operators nor a lone primary term costs a call or a vector per
+    // level. an operator has to be followed by an operand, the expression fails where one is missing. parentheses are
+    // up to primary, e.g. as a choice with delimited(tag('('), expression.ref(), tag(')')) of a Rule
+    template <AnyParser Primary, Operator... Operators>
+    auto expression(Primary primary, Operators... operators) -> ::pc::Parser<ParserValueType<Primary>> auto {
+        using T = ParserValueType<Primary>;
+        using Indices = std::index_sequence_for<Operators...>;
+        CharClass first_set = expression_first_set(primary, std::tie(operators...), Indices());
+        auto parser = recognizable([primary, operators = std::tuple(std::move(operators)...)](std::string_view input, auto mode) -> ModeResult<decltype(mode), T> {
+            if constexpr (recognizing<decltype(mode)>) {
+                // grouping does not change what is accepted, so recognizing only has to follow the operators
+                while (true) {
+                    while (auto op = match_operator<Fixity::prefix>(operators, input, Indices())) {
+                        input = op->rest;
+                    }
+                    auto operand = skip(primary, input);
+                    if (!operand) {
+                        return operand.error();
+                    }
+                    input = operand->second;
+                    while (auto op = match_operator<Fixity::postfix>(operators, input, Indices())) {
+                        input = op->rest;
+                    }
+                    auto op = match_operator<Fixity::infix>(operators, input, Indices());
+                    if (!op) {
+                        return success(Ignored(), input);
+                    }
+                    input = op->rest;
+                }
+            } else {
+                InlineVector<T, 8> operands;
+                InlineVector<PendingOperator, 8> pending;
+                // applies the pending operators that bind tighter than an operator of precedence, or as tightly when
+                // the operands group to the left
+                auto reduce = [&](int precedence, Associativity associativity) {
+                    while (!pending.empty() && (pending.back().precedence > precedence ||
+                               (pending.back().precedence == precedence && associativity == Associativity::left))) {
+                        apply_operator(operators, pending.back().index, operands, Indices());
+                        pending.pop_back();
+                    }
+                };
+
+                while (true) {
+                    while (auto op = match_operator<Fixity::prefix>(operators, input, Indices())) {
+                        pending.push_back({op->index, op->precedence});
+                        input = op->rest;
+                    }
+                    auto operand = std::invoke(primary, input);
+                    if (!operand) {
+                        return operand.error();
+                    }
+                    operands.push_back(std::move(operand->first));
+                    input = operand->second;
+
+                    while (auto op = match_operator<Fixity::postfix>(operators, input, Indices())) {
+                        reduce(op->precedence, Associativity::left);
+                        apply_operator(operators, op->index, operands, Indices());
+                        input = op->rest;
+                    }
+
+                    auto op = match_operator<Fixity::infix>(operators, input, Indices());
+                    if (!op) {
+                        break;
+                    }
+                    reduce(op->precedence, op->associativity);
+                    pending.push_back({op->index, op->precedence});
+                    input = op->rest;
+                }
+
+                while (!pending.empty()) {
+                    apply_operator(operators, pending.back().index, operands, Indices());
+                    pending.pop_back();
+                }
+                return success(std::move(operands.front()), input);
+            }
+        });
+
+        if constexpr (expression_has_first_set<Primary, Operators...>) {
+            return with_first_set(std::move(parser), first_set);
+        } else {
+            return parser;
+        }
+    }
+    // #endregion
+} // namespace pc::combinators
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <pc/pc.hpp>
+#include <pc/char_class.hpp>
+#include <pc/recognizer.hpp>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace pc {
+    // #region types
+    // a parser together with its first set: the bytes an input has to start with for the parser to succeed on it.
+    // the set may be larger than needed but never smaller, a parser that can succeed without consuming anything has
+    // every byte in it. choice uses the sets to skip alternatives that cannot match the next byte
+    template <typename P>
+    class WithFirstSet {
+    public:
+        constexpr WithFirstSet(P parser, CharClass first_set) : parser_(std::move(parser)), first_set_(first_set) {}
+
+        auto operator()(std::string_view input) const -> ParserResult<P> {
+            return std::invoke(parser_, input);
+        }
+
+        constexpr auto first_set() const -> const CharClass& {
+            return first_set_;
+        }
+
+        // the recognizer of parser, where it has one, see Recognizable
+        auto recognize(std::string_view input) const -> Result<Ignored> requires HasRecognizer<P> {
+            return parser_.recognize(input);
+        }
+
+    private:
+        P parser_;
+        CharClass first_set_;
+    };
+    // #endregion
+
+    // #region concepts
+    // whether a parser's type tells its first set, a compile time property even where the set itself is only known
+    // once the parser is built, as for tag
+    template <typename P>
+    concept HasFirstSet = AnyParser<P> &&
+        requires(const P& parser) {
+            { parser.first_set() } -> std::same_as<const CharClass&>;
+        };
+    // #endregion
+
+    // #region helpers
+    auto with_first_set(AnyParser auto parser, CharClass first_set) -> WithFirstSet<decltype(parser)> {
+        return {std::move(parser), first_set};
+    }
+
+    // every byte, the first set of parsers that may succeed whatever the input starts with
+    inline constexpr CharClass any_first_set = ~CharClass();
+
+    // parser with the first set of source, for combinators that only succeed where source does at the start of their
+    // input, or parser itself where source has no first set
+    auto with_first_set_of(AnyParser auto parser, const auto& source) {
+        if constexpr (HasFirstSet<std::remove_cvref_t<decltype(source)>>) {
+            return with_first_set(std::move(parser), source.first_set());
+        } else {
+            return parser;
+        }
+    }
+
+    // the first set of parser, every byte for a parser without one
+    constexpr auto first_set_of(const AnyParser auto& parser) -> CharClass {
+        if constexpr (HasFirstSet<std::remove_cvref_t<decltype(parser)>>) {
+            return parser.first_set();
+        } else {
+            return any_first_set;
+        }
+    }
+    // #endregion
+} // namespace pc
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <pc/pc.hpp>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace pc {
+    // #region types
+    enum class Status {
+        // an item was parsed, Step::value holds it
+        success,
+        // the buffered input is not enough to decide, feed more and call next again
+        incomplete,
+        // the item starting at Step::offset can not be parsed, however much more input arrives
+        rejected,
+        // finish was called and every buffered byte has been parsed
+        end,
+    };
+
+    template <typename T>
+    struct Step {
+        Status status;
+        std::optional<T> value;
+        // stream offset of the resumption point, where the next item starts
+        std::size_t offset;
+    };
+
+    // parses a stream of items with parser as the input arrives in chunks. only the bytes of the item in flight are
+    // buffered, consumed input is dropped as soon as an item is parsed.
+    //
+    // a parser only sees a prefix of the stream, so where any parser in it reached the end of the buffer, see
+    // reached_end, the outcome might turn out differently once more input arrives: a success or a failure is then
+    // reported as incomplete until finish is called, or until more than max_token_size bytes are buffered for one item,
+    // which then fails. an outcome the end of the buffer played no part in is final. values that point into the input,
+    // like string_views, are only valid until the next call to feed.
+    //
+    // parsers do not suspend, so an incomplete item is parsed again from its start. to keep an item fed in small chunks
+    // from costing a parse per chunk, quadratic in its size, it is only parsed again once its buffered bytes have
+    // doubled, or once finish is called. all the parses of an item then cost at most about two parses of it, but its
+    // outcome can be reported up to that many bytes late: an item completed by a chunk smaller than what is buffered
+    // stays incomplete until more arrives or the stream is finished.
+    template <AnyParser Parser>
+    class Incremental {
+    public:
+        using ValueType = ParserValueType<Parser>;
+
+        explicit Incremental(Parser parser, std::size_t max_token_size = std::numeric_limits<std::size_t>::max())
+            : parser_(std::move(parser)), max_token_size_(max_token_size) {}
+
+        void feed(std::string_view chunk) {
+            // drop the consumed prefix first, so the buffer never holds more than the item in flight plus a chunk
+            buffer_.erase(0, start_);
+            dropped_ += start_;
+            start_ = 0;
+            buffer_.append(chunk);
+        }
+
+        // no more input will arrive, the buffered bytes are parsed as the end of the stream
+        void finish() {
+            finished_ = true;
+        }
+
+        auto next() -> Step<ValueType> {
+            std::string_view input = pending();
+            if (input.empty()) {
+                return {finished_ ? Status::end : Status::incomplete, std::nullopt, offset()};
+            }
+
+            if (!finished_ && input.size() < retry_size_) {
+                return {Status::incomplete, std::nullopt, offset()};
+            }
+
+            auto outer = std::exchange(detail::end_watch, {input.data() + input.size(), false});
+            auto result = std::invoke(parser_, input);
+            bool reached = std::exchange(detail::end_watch, outer).reached;
+            if (!finished_ && reached) {
+                if (input.size() > max_token_size_) {
+                    return {Status::rejected, std::nullopt, offset()};
+                }
+                // past max_token_size_ it is rejected, so it is parsed again once there rather than waiting any longer
+                retry_size_ = 2 * input.size() > max_token_size_ ? max_token_size_ + 1 : 2 * input.size();
+                return {Status::incomplete, std::nullopt, offset()};
+            }
+
+            // an item has to consume input, or next would produce it forever
+            if (!result || result->second.size() == input.size()) {
+                return {Status::rejected, std::nullopt, offset()};
+            }
+
+            start_ += input.size() - result->second.size();
+            retry_size_ = 0;
+            return {Status::success, std::move(result->first), offset()};
+        }
+
+        // stream offset of the resumption point
+        auto offset() const -> std::size_t {
+            return dropped_ + start_;
+        }
+
+        // the input received but not yet consumed
+        auto pending() const -> std::string_view {
+            return std::string_view(buffer_).substr(start_);
+        }
+
+    private:
+        Parser parser_;
+        std::size_t max_token_size_;
+        std::string buffer_;
+        std::size_t start_ = 0;
+        std::size_t dropped_ = 0;
+        // the buffered bytes the item in flight waits for before it is parsed again
+        std::size_t retry_size_ = 0;
+        bool finished_ = false;
+    };
+    // #endregion
+
+    // #region helpers
+    auto incremental(AnyParser auto parser, std::size_t max_token_size = std::numeric_limits<std::size_t>::max())
+    -> Incremental<decltype(parser)> {
+        return Incremental<decltype(parser)>(std::move(parser), max_token_size);
+    }
+    // #endregion
+} // namespace pc
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace pc {
+    // #region types
+    // a vector holding its first N elements inside itself, only allocating once it grows past them. for repetitions
+    // that mostly produce a handful of values, collected with e.g. many0(parser, InlineVector<T, 4>())
+    template <typename T, std::size_t N>
+    class InlineVector {
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        // user provided, so that the inline storage is left uninitialized rather than zeroed
+        InlineVector() {}
+
+        InlineVector(std::initializer_list<T> values) {
+            reserve(values.size());
+            std::uninitialized_copy(values.begin(), values.end(), data());
+            size_ = values.size();
+        }
+
+        InlineVector(const InlineVector& other) {
+            reserve(other.size_);
+            std::uninitialized_copy(other.begin(), other.end(), data());
+            size_ = other.size_;
+        }
+
+        // moving inline elements moves each of them, so the move only promises not to throw where they do
+        InlineVector(InlineVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+            take(std::move(other));
+        }
+
+        auto operator=(const InlineVector& other) -> InlineVector& {
+            if (this != &other) {
+                clear();
+                reserve(other.size_);
+                std::uninitialized_copy(other.begin(), other.end(), data());
+                size_ = other.size_;
+            }
+            return *this;
+        }
+
+        auto operator=(InlineVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) -> InlineVector& {
+            if (this != &other) {
+                clear();
+                deallocate();
+                take(std::move(other));
+            }
+            return *this;
+        }
+
+        ~InlineVector() {
+            clear();
+            deallocate();
+        }
+
+        static constexpr auto inline_capacity() -> size_type {
+            return N;
+        }
+
+        auto size() const -> size_type {
+            return size_;
+        }
+
+        auto empty() const -> bool {
+            return size_ == 0;
+        }
+
+        auto capacity() const -> size_type {
+            return heap_ != nullptr ? heap_capacity_ : N;
+        }
+
+        // whether the elements are still inside the vector itself
+        auto is_inline() const -> bool {
+            return heap_ == nullptr;
+        }
+
+        auto data() -> T* {
+            return heap_ != nullptr ? heap_ : reinterpret_cast<T*>(inline_.data());
+        }
+
+        auto data() const -> const T* {
+            return heap_ != nullptr ? heap_ : reinterpret_cast<const T*>(inline_.data());
+        }
+
+        auto begin() -> iterator {
+            return data();
+        }
+
+        auto end() -> iterator {
+            return data() + size_;
+        }
+
+        auto begin() const -> const_iterator {
+            return data();
+        }
+
+        auto end() const -> const_iterator {
+            return data() + size_;
+        }
+
+        auto operator[](size_type i) -> T& {
+            return data()[i];
+        }
+
+        auto operator[](size_type i) const -> const T& {
+            return data()[i];
+        }
+
+        auto front() -> T& {
+            return data()[0];
+        }
+
+        auto front() const -> const T& {
+            return data()[0];
+        }
+
+        auto back() -> T& {
+            return data()[size_ - 1];
+        }
+
+        auto back() const -> const T& {
+            return data()[size_ - 1];
+        }
+
+        void reserve(size_type capacity) {
+            if (capacity > this->capacity()) {
+                T* elements = std::allocator<T>().allocate(capacity);
+                relocate(elements, capacity);
+            }
+        }
+
+        template <typename... Args>
+        auto emplace_back(Args&&... args) -> T& {
+            if (size_ < capacity()) {
+                T* element = std::construct_at(data() + size_, std::forward<Args>(args)...);
+                ++size_;
+                return *element;
+            }
+            // the new element is constructed before the old ones move, as args may refer to one of them
+            size_type capacity = std::max<size_type>(2 * size_, 1);
+            T* elements = std::allocator<T>().allocate(capacity);
+            std::construct_at(elements + size_, std::forward<Args>(args)...);
+            relocate(elements, capacity);
+            ++size_;
+            return back();
+        }
+
+        void push_back(const T& value) {
+            emplace_back(value);
+        }
+
+        void push_back(T&& value) {
+            emplace_back(std::move(value));
+        }
+
+        void pop_back() {
+            --size_;
+            std::destroy_at(data() + size_);
+        }
+
+        // destroys the elements, keeping the capacity
+        void clear() {
+            std::destroy(begin(), end());
+            size_ = 0;
+        }
+
+        friend auto operator==(const InlineVector& lhs, const InlineVector& rhs) -> bool {
+            return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        }
+
+    private:
+        // moves the elements to elements, which holds capacity of them, and frees where they were on the heap
+        void relocate(T* elements, size_type capacity) {
+            std::uninitialized_move(begin(), end(), elements);
+            std::destroy(begin(), end());
+            deallocate();
+            heap_ = elements;
+            heap_capacity_ = capacity;
+        }
+
+        void deallocate() {
+            if (heap_ != nullptr) {
+                std::allocator<T>().deallocate(heap_, heap_capacity_);
+                heap_ = nullptr;
+                heap_capacity_ = 0;
+            }
+        }
+
+        // the elements of other, which is left empty. heap elements change owner, inline ones are moved one by one
+        void take(InlineVector&& other) {
+            if (other.heap_ != nullptr) {
+                heap_ = std::exchange(other.heap_, nullptr);
+                heap_capacity_ = std::exchange(other.heap_capacity_, 0);
+                size_ = std::exchange(other.size_, 0);
+            } else {
+                std::uninitialized_move(other.begin(), other.end(), data());
+                size_ = other.size_;
+                other.clear();
+            }
+        }
+
+        alignas(T) std::array<std::byte, sizeof(T) * N> inline_;
+        T* heap_ = nullptr;
+        size_type heap_capacity_ = 0;
+        size_type size_ = 0;
+    };
+    // #endregion
+} // namespace pc
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <pc/pc.hpp>
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+
+namespace pc {
+    // #region types
+    // a file mapped read only into memory, hinted for one sequential pass. string_views into it, including zero copy
+    // parse results, are valid for as long as the mapping lives
+    class MappedInput {
+    public:
+        // nullopt if the file can not be opened or mapped
+        static auto open(const std::filesystem::path& path) -> std::optional<MappedInput>;
+
+        MappedInput(MappedInput&& other) noexcept;
+        MappedInput& operator=(MappedInput&& other) noexcept;
+        MappedInput(const MappedInput&) = delete;
+        MappedInput& operator=(const MappedInput&) = delete;
+        ~MappedInput();
+
+        auto view() const -> std::string_view {
+            return std::string_view(data_, size_);
+        }
+
+        operator std::string_view() const {
+            return view();
+        }
+
+    private:
+        MappedInput(const char* data, std::size_t size, bool owned) : data_(data), size_(size), owned_(owned) {}
+
+        void reset();
+
+        const char* data_ = nullptr;
+        std::size_t size_ = 0;
+        // true when data_ was read into a heap buffer on platforms without mmap
+        bool owned_ = false;
+    };
+
+    template <typename T>
+    struct ParsedFile {
+        // keeps the file mapped, result may point into it
+        MappedInput input;
+        Result<T> result;
+    };
+    // #endregion
+
+    // #region helpers
+    // maps the file at path and runs parser over all of it, nullopt if the file can not be opened or mapped
+    auto parse_file(const std::filesystem::path& path, AnyParser auto parser) -> std::optional<ParsedFile<ParserValueType<decltype(parser)>>> {
+        auto input = MappedInput::open(path);
+        if (!input) {
+            return std::nullopt;
+        }
+        auto result = std::invoke(parser, input->view());
+        return ParsedFile<ParserValueType<decltype(parser)>>{std::move(*input), std::move(result)};
+    }
+    // #endregion
+} // namespace pc
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <pc/pc.hpp>
+#include <pc/first_set.hpp>
+#include <pc/recognizer.hpp>
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace pc {
+    // #region types
+    template <typename T>
+    class MemoTable;
+
+    // what the memo tables of one parse share: their size, the generation telling current results from old ones, and
+    // the counts of their lookups. the tables, one per memo rule, belong to the rules, so building a grammar again,
+    // e.g. once per document, adds nothing to a context that is reused. each table is keyed by the position and end
+    // of the input the rule was given, and direct mapped with a fixed number of slots, so memory stays bounded however
+    // large the input: a result evicted by another position is simply parsed again. reset() forgets every result of
+    // every table at once, by moving to the next generation, and has to be called before parsing another input: the
+    // keys are only pointers and sizes, so another input at the same address, like a buffer refilled in place, would
+    // be answered with the results of the old one. debug builds assert on the first byte of the input where they can.
+    // like Arena it is not thread safe, a context serves one parse at a time
+    class MemoContext {
+    public:
+        // slots per rule, rounded up to a power of two
+        explicit MemoContext(std::size_t slots = 1024) : slots_(std::bit_ceil(std::max<std::size_t>(slots, 1))) {}
+
+        MemoContext(const MemoContext&) = delete;
+        MemoContext& operator=(const MemoContext&) = delete;
+
+        void reset() {
+            ++generation_;
+        }
+
+        auto slots() const -> std::size_t {
+            return slots_;
+        }
+
+        // lookups answered from a table and lookups that had to parse, since construction
+        auto hits() const -> std::size_t {
+            return hits_;
+        }
+
+        auto misses() const -> std::size_t {
+            return misses_;
+        }
+
+    private:
+        template <typename T>
+        friend class MemoTable;
+
+        std::size_t slots_;
+        // entries of other generations are empty, starting at 1 lets the zeroed entries of a new table be empty too
+        std::uint64_t generation_ = 1;
+        std::size_t hits_ = 0;
+        std::size_t misses_ = 0;
+    };
+
+    template <typename T>
+    class MemoTable {
+    public:
+        explicit MemoTable(MemoContext& context) : context_(context), entries_(context.slots()) {}
+
+        // the result memoized for input in the current parse, or null
+        auto find(std::string_view input) -> const Result<T>* {
+            const Entry& entry = entries_[index(input)];
+            if (entry.generation == context_.generation_ && entry.begin == input.data() && entry.size == input.size()) {
+#if PC_DEBUG
+                assert((input.empty() || entry.first == input.front()) && "MemoContext reused for another input without reset()");
+#endif
+                ++context_.hits_;
+                return &entry.result;
+            }
+            ++context_.misses_;
+            return nullptr;
+        }
+
+        void store(std::string_view input, const Result<T>& result) {
+            Entry& entry = entries_[index(input)];
+            entry.begin = input.data();
+            entry.size = input.size();
+            entry.generation = context_.generation_;
+#if PC_DEBUG
+            entry.first = input.empty() ? '\0' : input.front();
+#endif
+            entry.result = result;
+        }
+
+    private:
+        struct Entry {
+            const char* begin = nullptr;
+            std::size_t size = 0;
+            std::uint64_t generation = 0;
+#if PC_DEBUG
+            char first = '\0';
+#endif
+            Result<T> result;
+        };
+
+        // neighbouring positions land in neighbouring slots, so a window of slots bytes of input never collides
+        auto index(std::string_view input) const -> std::size_t {
+            return reinterpret_cast<std::uintptr_t>(input.data()) & (entries_.size() - 1);
+        }
+
+        MemoContext& context_;
+        std::vector<Entry> entries_;
+    };
+    // #endregion
+
+    // #region helpers
+    // parser, with its results, failures included, reused whenever it is called again at the same position of the same
+    // input within one parse of context. meant for rules that choice and tuple backtrack into over and over, each memo
+    // is a rule of its own, and its copies share its tables. it keeps parser's first set and recognizer: recognizing
+    // answers from the parsed results too, and memoizes its own in a second table, without values. a hit returns a
+    // copy of the memoized Result, so where values are costly to copy, like vectors or strings, memoizing a view of
+    // them or recognizing is cheaper. context has to outlive the returned parser
+    auto memo(MemoContext& context, AnyParser auto parser) -> Parser<ParserValueType<decltype(parser)>> auto {
+        using T = ParserValueType<decltype(parser)>;
+        auto table = std::make_shared<MemoTable<T>>(context);
+        auto recognized = std::make_shared<MemoTable<Ignored>>(context);
+        return with_first_set_of(recognizable([table, recognized, parser](std::string_view input, auto mode) -> ModeResult<decltype(mode), T> {
+            if constexpr (recognizing<decltype(mode)>) {
+                if (const Result<T>* memoized = table->find(input)) {
+                    if (!*memoized) {
+                        return memoized->error();
+                    }
+                    return success(Ignored(), (*memoized)->second);
+                }
+                if (const Result<Ignored>* memoized = recognized->find(input)) {
+                    return *memoized;
+                }
+                Result<Ignored> result = skip(parser, input);
+                recognized->store(input, result);
+                return result;
+            } else {
+                if (const Result<T>* memoized = table->find(input)) {
+                    return *memoized;
+                }
+                Result<T> result = std::invoke(parser, input);
+                table->store(input, result);
+                return result;
+            }
+        }), parser);
+    }
+    // #endregion
+} // namespace pc
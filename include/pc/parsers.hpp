@@ -3,38 +3,491 @@
 
 #include <pc/pc.hpp>
 #include <pc/combinators.hpp>
+#include <pc/char_class.hpp>
+#include <pc/first_set.hpp>
+#include <pc/recognizer.hpp>
+#include <pc/simd.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <string>
 #include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace pc::parsers {
+    namespace {
+        // the first byte of a tag, or every byte for the empty tag that matches anywhere
+        constexpr auto tag_first_set(std::string_view prefix) -> CharClass {
+            return prefix.empty() ? any_first_set : CharClass(prefix.substr(0, 1));
+        }
+
+        // a tag failing on input that is all a start of the tag would match once more input follows
+        inline auto tag_failure(std::string_view input, std::string_view prefix) -> Error {
+            if (prefix.starts_with(input)) {
+                reached_end(input);
+            }
+            return failure_at(input, prefix);
+        }
+    }
+
     auto character(std::string_view input) -> Result<char>;
     static_assert(AnyParser<decltype(character)>);
     auto newline(std::string_view input) -> Result<char>;
     static_assert(AnyParser<decltype(newline)>);
-    auto line(std::string_view input) -> Result<std::string>;
+    // like line, but the value is a slice of the input rather than a copy, so it is only valid while the input is
+    auto line_view(std::string_view input) -> Result<std::string_view>;
+    static_assert(AnyParser<decltype(line_view)>);
+    // an object rather than a function, so that recognizing it does not copy the line
+    inline constexpr auto line = recognizable([](std::string_view input, auto mode) -> ModeResult<decltype(mode), std::string> {
+        auto result = line_view(input);
+        if (!result) {
+            return result.error();
+        }
+        if constexpr (recognizing<decltype(mode)>) {
+            return success(Ignored(), result->second);
+        } else {
+            return success(std::string(result->first), result->second);
+        }
+    });
     static_assert(AnyParser<decltype(line)>);
 
     template <typename T>
     inline auto fail(std::string_view input) -> Result<T> {
-        return failure;
+        return failure_at(input);
     }
     static_assert(AnyParser<decltype(fail<char>)>);
 
     inline auto tag(std::string_view prefix) -> Parser<std::string> auto {
-        return [prefix](std::string_view input) -> Result<std::string> {
+        return with_first_set(recognizable([prefix](std::string_view input, auto mode) -> ModeResult<decltype(mode), std::string> {
             if (input.starts_with(prefix)) {
-                return success<std::string>(std::string(prefix), input.substr(prefix.size()));
+                if constexpr (recognizing<decltype(mode)>) {
+                    return success(Ignored(), input.substr(prefix.size()));
+                } else {
+                    return success<std::string>(std::string(prefix), input.substr(prefix.size()));
+                }
             }
-            return failure;
-        };
+            return tag_failure(input, prefix);
+        }), tag_first_set(prefix));
+    }
+
+    // like tag, but the value is the matched slice of the input rather than a copy of the prefix
+    inline auto tag_view(std::string_view prefix) -> Parser<std::string_view> auto {
+        return with_first_set([prefix](std::string_view input) -> Result<std::string_view> {
+            if (input.starts_with(prefix)) {
+                return success(input.substr(0, prefix.size()), input.substr(prefix.size()));
+            }
+            return tag_failure(input, prefix);
+        }, tag_first_set(prefix));
     }
 
     inline auto tag(char prefix) -> Parser<char> auto {
-        return [prefix](std::string_view input) -> Result<char> {
+        return with_first_set([prefix](std::string_view input) -> Result<char> {
             if (!input.empty() && input.at(0) == prefix) {
                 return success(prefix, input.substr(1));
             }
-            return failure;
+            if (input.empty()) {
+                reached_end(input);
+            }
+            return failure_at(input, char_string(prefix));
+        }, CharClass(std::string_view(&prefix, 1)));
+    }
+
+    // the value of tag<Literal>(), empty as the matched bytes are known from its type
+    template <FixedString Literal>
+    struct Tag {
+        static constexpr std::string_view text = Literal.view();
+
+        constexpr auto operator==(const Tag&) const -> bool = default;
+    };
+
+    namespace {
+        // the bytes of Literal from Offset on, loaded like the input so the comparison holds on either endianness
+        template <FixedString Literal, typename Word, std::size_t Offset>
+        constexpr Word literal_word = [] {
+            std::array<char, sizeof(Word)> bytes{};
+            for (std::size_t i = 0; i < bytes.size(); ++i) {
+                bytes[i] = Literal.chars[Offset + i];
+            }
+            return std::bit_cast<Word>(bytes);
+        }();
+
+        template <FixedString Literal, typename Word, std::size_t Offset>
+        auto same_word(const char* input) -> bool {
+            Word word;
+            std::memcpy(&word, input + Offset, sizeof(Word));
+            return word == literal_word<Literal, Word, Offset>;
+        }
+
+        // whether input starts with Literal, comparing whole words with the literal's bytes as constants. the words
+        // overlap rather than fall back to a byte loop for the last few bytes, and are combined with & so the only
+        // branch is on the length of the input
+        template <FixedString Literal>
+        constexpr auto starts_with_literal(std::string_view input) -> bool {
+            constexpr std::size_t size = Literal.size();
+            if (input.size() < size) {
+                return false;
+            }
+            if (std::is_constant_evaluated()) {
+                return input.starts_with(Literal.view());
+            }
+            const char* data = input.data();
+            if constexpr (size == 0) {
+                return true;
+            } else if constexpr (size == 1) {
+                return data[0] == Literal.chars[0];
+            } else if constexpr (size < 4) {
+                return same_word<Literal, std::uint16_t, 0>(data) & same_word<Literal, std::uint16_t, size - 2>(data);
+            } else if constexpr (size < 8) {
+                return same_word<Literal, std::uint32_t, 0>(data) & same_word<Literal, std::uint32_t, size - 4>(data);
+            } else {
+                return [data]<std::size_t... I>(std::index_sequence<I...>) {
+                    return (same_word<Literal, std::uint64_t, I * 8>(data) & ... & same_word<Literal, std::uint64_t, size - 8>(data));
+                }(std::make_index_sequence<(size - 1) / 8>());
+            }
+        }
+    }
+
+    // tag with the literal as a template argument: the parser holds nothing, its first set is known at compile time
+    // and the value is an empty Tag rather than a copy of the literal
+    template <FixedString Literal>
+    class LiteralTag {
+    public:
+        auto operator()(std::string_view input) const -> Result<Tag<Literal>> {
+            if (starts_with_literal<Literal>(input)) {
+                return success(Tag<Literal>(), input.substr(Literal.size()));
+            }
+            return tag_failure(input, Literal.view());
+        }
+
+        constexpr auto first_set() const -> const CharClass& {
+            return first_set_;
+        }
+
+    private:
+        static constexpr CharClass first_set_ = tag_first_set(Literal.view());
+    };
+
+    template <FixedString Literal>
+    constexpr auto tag() -> Parser<Tag<Literal>> auto {
+        return LiteralTag<Literal>();
+    }
+
+    // the longest prefix of the input made of bytes in char_class, possibly empty, as a slice of the input
+    inline auto take_while0(CharClass char_class) -> Parser<std::string_view> auto {
+        return [char_class](std::string_view input) -> Result<std::string_view> {
+            auto length = simd::prefix_length(input, char_class);
+            if (length == input.size()) {
+                reached_end(input);
+            }
+            return success(input.substr(0, length), input.substr(length));
+        };
+    }
+
+    // like take_while0, but fails unless at least one byte matches
+    inline auto take_while1(CharClass char_class) -> Parser<std::string_view> auto {
+        return with_first_set([char_class](std::string_view input) -> Result<std::string_view> {
+            auto length = simd::prefix_length(input, char_class);
+            if (length == input.size()) {
+                reached_end(input);
+            }
+            if (length == 0) {
+                return failure_at(input);
+            }
+            return success(input.substr(0, length), input.substr(length));
+        }, char_class);
+    }
+
+    namespace {
+        // a byte of the result is non zero where the byte of word, loaded from the input, is no digit: a digit's high
+        // nibble is 3, and still is with 6 added, which carries it to 4 for the bytes past '9'. only the lowest non zero
+        // byte is exact, the bytes past it may have a carry spilled into them
+        constexpr auto non_digits(std::uint64_t word) -> std::uint64_t {
+            return ((word & 0xF0F0F0F0F0F0F0F0) | (((word + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ^ 0x3333333333333333;
+        }
+
+        // the value of 8 digits loaded little endian, the first digit in the lowest byte, where zero bytes count as
+        // leading zeros. adjacent digits are combined into pairs, pairs into fours and fours into the whole, a multiply
+        // each
+        constexpr auto eight_digits_value(std::uint64_t word) -> std::uint64_t {
+            word = ((word & 0x0F0F0F0F0F0F0F0F) * 2561) >> 8;
+            word = ((word & 0x00FF00FF00FF00FF) * 6553601) >> 16;
+            return ((word & 0x0000FFFF0000FFFF) * 42949672960001) >> 32;
+        }
+
+        inline constexpr std::array<std::uint64_t, 8> powers_of_ten = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000};
+
+        // the digits are only read a word at a time where the word puts the first byte lowest
+        inline constexpr bool swar_digits = std::endian::native == std::endian::little;
+
+        inline auto load_word(const char* input) -> std::uint64_t {
+            std::uint64_t word;
+            std::memcpy(&word, input, sizeof(word));
+            return word;
+        }
+
+        // the number of digits input starts with
+        inline auto digit_count(std::string_view input) -> std::size_t {
+            std::size_t count = 0;
+            if constexpr (swar_digits) {
+                while (input.size() - count >= 8 && non_digits(load_word(input.data() + count)) == 0) {
+                    count += 8;
+                }
+            }
+            while (count < input.size() && is_digit(input[count])) {
+                ++count;
+            }
+            return count;
+        }
+
+        // at most 19 digits, which always fit, 20 standing for more of them whatever their value
+        struct Digits {
+            std::uint64_t value = 0;
+            std::size_t count = 0;
         };
+
+        // the digits input starts with in a single pass, a word at a time for the first 16 where 8 bytes of input are
+        // left, then byte by byte
+        inline auto read_digits(std::string_view input) -> Digits {
+            Digits digits;
+            if constexpr (swar_digits) {
+                while (input.size() - digits.count >= 8 && digits.count < 16) {
+                    std::uint64_t word = load_word(input.data() + digits.count);
+                    std::uint64_t non_digit = non_digits(word);
+                    if (non_digit == 0) {
+                        digits.value = digits.value * 100000000 + eight_digits_value(word);
+                        digits.count += 8;
+                        continue;
+                    }
+                    // the digits before the first non digit, shifted to the top of the word so the bytes below them
+                    // read as leading zeros
+                    std::size_t count = static_cast<std::size_t>(std::countr_zero(non_digit)) / 8;
+                    if (count > 0) {
+                        digits.value = digits.value * powers_of_ten[count] + eight_digits_value(word << (64 - 8 * count));
+                        digits.count += count;
+                    }
+                    return digits;
+                }
+            }
+            for (; digits.count < input.size() && is_digit(input[digits.count]); ++digits.count) {
+                if (digits.count == 19) {
+                    return {0, 20};
+                }
+                digits.value = digits.value * 10 + static_cast<std::uint64_t>(input[digits.count] - '0');
+            }
+            return digits;
+        }
+
+        template <std::integral T>
+        auto parse_integer(std::string_view input) -> Result<T> {
+            std::size_t sign = std::is_signed_v<T> && !input.empty() && input[0] == '-' ? 1 : 0;
+            Digits digits = read_digits(input.substr(sign));
+            if (digits.count == 0) {
+                if (sign == input.size()) {
+                    reached_end(input);
+                }
+                return failure_at(input, "an integer");
+            }
+            if (digits.count > 19) {
+                // too many digits to add up without checking every step, or leading zeros, from_chars checks
+                std::string_view rest = input.substr(sign + digit_count(input.substr(sign)));
+                if (rest.empty()) {
+                    reached_end(input);
+                }
+                T value;
+                if (std::from_chars(input.data(), rest.data(), value).ec != std::errc()) {
+                    return failure_at(input, "an integer in range");
+                }
+                return success(value, rest);
+            }
+
+            if (sign + digits.count == input.size()) {
+                reached_end(input);
+            }
+            std::uint64_t limit = static_cast<std::uint64_t>(std::numeric_limits<T>::max()) + sign;
+            if (digits.value > limit) {
+                return failure_at(input, "an integer in range");
+            }
+            // negated modulo 2^64, which converts to T as the negative value
+            return success(static_cast<T>(sign == 1 ? 0 - digits.value : digits.value), input.substr(sign + digits.count));
+        }
+    }
+
+    // a decimal integer of type T, led by a '-' where T is signed, that fails rather than overflow. digits are read 8
+    // at a time, and nothing is allocated. like std::from_chars, there is no '+' and leading zeros are allowed
+    template <std::integral T>
+        requires (!std::same_as<T, bool>)
+    auto integer() -> Parser<T> auto {
+        constexpr CharClass first_set = std::is_signed_v<T> ? char_classes::digit | CharClass("-") : char_classes::digit;
+        return with_first_set([](std::string_view input) -> Result<T> {
+            return parse_integer<T>(input);
+        }, first_set);
+    }
+
+    namespace {
+        // the length of the number input starts with: a sign, digits with an optional fraction, at least one digit in
+        // either, and an exponent where one with digits follows. 0 where there is no number
+        inline auto number_length(std::string_view input) -> std::size_t {
+            std::size_t length = !input.empty() && (input[0] == '-' || input[0] == '+') ? 1 : 0;
+            std::size_t digits = digit_count(input.substr(length));
+            length += digits;
+            if (length < input.size() && input[length] == '.') {
+                std::size_t fraction = digit_count(input.substr(length + 1));
+                digits += fraction;
+                length += 1 + fraction;
+            }
+            // every part, down to the exponent's digits, ends where a byte stops it or at the end of input
+            std::size_t scanned = length;
+            if (digits > 0 && length < input.size() && (input[length] == 'e' || input[length] == 'E')) {
+                std::size_t exponent = length + 1;
+                if (exponent < input.size() && (input[exponent] == '-' || input[exponent] == '+')) {
+                    ++exponent;
+                }
+                std::size_t exponent_digits = digit_count(input.substr(exponent));
+                scanned = exponent + exponent_digits;
+                if (exponent_digits > 0) {
+                    length = scanned;
+                }
+            }
+            if (scanned == input.size()) {
+                reached_end(input);
+            }
+            return digits == 0 ? 0 : length;
+        }
+
+        // whether number, checked by number_length, is at least 1, from the power of ten of its first significant digit
+        // and its exponent. only asked of numbers from_chars found out of range, which are far from 1 either way
+        inline auto number_above_one(std::string_view number) -> bool {
+            std::size_t sign = number[0] == '-' || number[0] == '+' ? 1 : 0;
+            std::string_view digits = number.substr(sign);
+            std::size_t integer_digits = digit_count(digits);
+            std::size_t first = digits.find_first_not_of("0.");
+            std::int64_t power = first < integer_digits
+                ? static_cast<std::int64_t>(integer_digits - first) - 1
+                : static_cast<std::int64_t>(integer_digits) - static_cast<std::int64_t>(first);
+
+            std::size_t e = digits.find_first_of("eE");
+            if (e != std::string_view::npos) {
+                std::string_view exponent = digits.substr(e + 1);
+                bool negative = exponent[0] == '-';
+                if (exponent[0] == '-' || exponent[0] == '+') {
+                    exponent.remove_prefix(1);
+                }
+                exponent.remove_prefix(std::min(exponent.find_first_not_of('0'), exponent.size()));
+                // any exponent past what a double reaches is as good as another
+                std::int64_t value = 0;
+                for (char c : exponent.substr(0, 9)) {
+                    value = value * 10 + (c - '0');
+                }
+                power += negative ? -value : value;
+            }
+            return power >= 0;
+        }
+
+        // the syntax is checked here, from_chars only converts. libstdc++ does so with the Eisel-Lemire algorithm,
+        // falling back to exact big number arithmetic for the rare inputs it cannot round on its own
+        template <std::floating_point T>
+        auto parse_floating_point(std::string_view input) -> Result<T> {
+            std::size_t length = number_length(input);
+            if (length == 0) {
+                return failure_at(input, "a number");
+            }
+            // from_chars takes no '+'
+            std::size_t plus = input[0] == '+' ? 1 : 0;
+            T value;
+            if (std::from_chars(input.data() + plus, input.data() + length, value).ec == std::errc::result_out_of_range) {
+                // like strtod, a number past the range of T is infinity and one too small to tell from 0 is 0, signed
+                value = number_above_one(input.substr(0, length)) ? std::numeric_limits<T>::infinity() : T(0);
+                if (input[0] == '-') {
+                    value = -value;
+                }
+            }
+            return success(value, input.substr(length));
+        }
+    }
+
+    // a decimal number of type T, as JSON and CSV write them: "-12", "3.25", "1e-7", "6.02E+23", and also "+1", ".5" and
+    // "5.", but no "inf" or "nan". the value is the nearest T, as strtod would round it, by std::from_chars straight
+    // from the input. as with strtod, a number too large for T is an infinity and one too small to be told from 0 is 0
+    template <std::floating_point T>
+    auto floating_point() -> Parser<T> auto {
+        constexpr CharClass first_set = char_classes::digit | CharClass("-+.");
+        return with_first_set([](std::string_view input) -> Result<T> {
+            return parse_floating_point<T>(input);
+        }, first_set);
+    }
+
+    // the tags of one_of_tags compiled into a dfa over the bytes they use, so matching is a table lookup per byte of
+    // input however many tags there are
+    class TagTrie {
+    public:
+        explicit TagTrie(std::span<const std::string_view> tags);
+
+        // the index of the longest tag the input starts with, the first one listed among equal tags, and its length
+        auto longest_match(std::string_view input) const -> std::optional<std::pair<std::size_t, std::size_t>> {
+            std::optional<std::pair<std::size_t, std::size_t>> match;
+            std::size_t node = 0;
+            for (std::size_t i = 0;; ++i) {
+                if (accept_[node] != 0) {
+                    match.emplace(accept_[node] - 1, i);
+                }
+                if (i == input.size()) {
+                    // a longer tag could only match where the node has a child
+                    if (std::ranges::any_of(std::span(next_).subspan(node * width_, width_), [](std::uint32_t child) { return child != 0; })) {
+                        reached_end(input);
+                    }
+                    break;
+                }
+                // bytes in no tag have class 0, which has no transitions, and no transition leads back to the root
+                node = next_[node * width_ + classes_[static_cast<unsigned char>(input[i])]];
+                if (node == 0) {
+                    break;
+                }
+            }
+            return match;
+        }
+
+        // the first bytes of the tags, every byte once the empty tag is one of them
+        auto first_set() const -> CharClass;
+
+    private:
+        std::array<std::uint16_t, 256> classes_{};
+        // the number of classes, 0 included
+        std::size_t width_ = 1;
+        // a row of width_ entries per node, the root's first. node * width_ + class to the next node
+        std::vector<std::uint32_t> next_;
+        // per node 1 + the index of the tag ending at it, or 0
+        std::vector<std::size_t> accept_;
+    };
+
+    // which of tags the input starts with as its index in tags, the longest one where several match. the tags are
+    // only read while the parser is built
+    inline auto one_of_tags(std::span<const std::string_view> tags) -> Parser<std::size_t> auto {
+        auto trie = std::make_shared<const TagTrie>(tags);
+        CharClass first_set = trie->first_set();
+        return with_first_set([trie](std::string_view input) -> Result<std::size_t> {
+            if (auto match = trie->longest_match(input)) {
+                return success(match->first, input.substr(match->second));
+            }
+            return failure_at(input);
+        }, first_set);
+    }
+
+    inline auto one_of_tags(std::initializer_list<std::string_view> tags) -> Parser<std::size_t> auto {
+        return one_of_tags(std::span(tags.begin(), tags.size()));
     }
 
     auto unit(auto value) -> Parser<decltype(value)> auto {
@@ -50,18 +503,51 @@ namespace pc::parsers {
             if (iter != input.end()) {
                 return success(*iter, input.substr((iter - input.begin()) + 1));
             }
-            return failure;
+            // every byte was looked at, so the failure is at the end
+            reached_end(input);
+            return failure_at(input.substr(input.size()));
         };
     }
 
     auto last_char_match(std::predicate<char> auto fn) -> Parser<char> auto {
         return [fn](std::string_view input) -> Result<char> {
+            reached_end(input);
             auto iter = std::ranges::find_if(input.rbegin(), input.rend(), fn);
             if (iter != input.rend()) {
                 auto pos = std::distance(iter, input.rend()) - 1;
                 return success(*iter, input.substr(0, pos));
             }
-            return failure;
+            return failure_at(input);
         };
     }
 } // namespace pc::parsers
+
+// the string producing parsers, allocating their values from a memory resource, e.g. a pc::Arena scoped to the parse
+namespace pc::parsers::pmr {
+    inline auto line(std::pmr::memory_resource* resource) -> Parser<std::pmr::string> auto {
+        return recognizable([resource](std::string_view input, auto mode) -> ModeResult<decltype(mode), std::pmr::string> {
+            auto result = line_view(input);
+            if (!result) {
+                return result.error();
+            }
+            if constexpr (recognizing<decltype(mode)>) {
+                return success(Ignored(), result->second);
+            } else {
+                return success(std::pmr::string(result->first, resource), result->second);
+            }
+        });
+    }
+
+    inline auto tag(std::string_view prefix, std::pmr::memory_resource* resource) -> Parser<std::pmr::string> auto {
+        return with_first_set(recognizable([prefix, resource](std::string_view input, auto mode) -> ModeResult<decltype(mode), std::pmr::string> {
+            if (input.starts_with(prefix)) {
+                if constexpr (recognizing<decltype(mode)>) {
+                    return success(Ignored(), input.substr(prefix.size()));
+                } else {
+                    return success(std::pmr::string(prefix, resource), input.substr(prefix.size()));
+                }
+            }
+            return tag_failure(input, prefix);
+        }), tag_first_set(prefix));
+    }
+} // namespace pc::parsers::pmr
@@ -1,20 +1,209 @@
 
 #pragma once
 
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
 #include <string_view>
 #include <type_traits>
 #include <utility>
 
 namespace pc {
     // #region types
+    // where a parse failed and what would have matched there. the expectations are views of strings that outlive the
+    // parse, string literals or the strings a parser was built from, so recording a failure never allocates
+    class Error {
+    public:
+        static constexpr std::size_t capacity = 3;
+
+        // points into the input, null when the failing parser did not say where
+        const char* position = nullptr;
+
+        // a failure no other alternative may recover from, like a rule nested past its depth limit. choice and the
+        // repetitions hand it on rather than backtrack, so it fails the whole parse
+        bool fatal = false;
+
+        auto count() const -> std::size_t {
+            return count_;
+        }
+
+        // the i-th of count() expectations
+        auto expected(std::size_t i) const -> std::string_view {
+            return std::string_view(expected_[i].data, expected_[i].size);
+        }
+
+        // records that expected would have matched at position, unless it is already recorded or there is no room left
+        void expect(std::string_view expected) {
+            for (std::size_t i = 0; i < count_; ++i) {
+                // the same expectation is the same view, so comparing the views themselves is enough
+                if (expected_[i].data == expected.data() && expected_[i].size == expected.size()) {
+                    return;
+                }
+            }
+            if (count_ < capacity) {
+                expected_[count_++] = {expected.data(), expected.size()};
+            }
+        }
+
+        // offset of the failure from the start of input, the input the whole parse was given
+        auto offset(std::string_view input) const -> std::optional<std::size_t> {
+            if (position == nullptr) {
+                return std::nullopt;
+            }
+            return static_cast<std::size_t>(position - input.data());
+        }
+
+        // keeps whichever failure got further into the input, or the expectations of both if they failed at the same
+        // position
+        auto merge(const Error& other) -> Error& {
+            if (fatal || other.fatal) {
+                return fatal ? *this : *this = other;
+            }
+            if (other.position == nullptr || (position != nullptr && other.position < position)) {
+                return *this;
+            }
+            if (position == nullptr || other.position > position) {
+                return *this = other;
+            }
+            for (std::size_t i = 0; i < other.count_; ++i) {
+                expect(other.expected(i));
+            }
+            return *this;
+        }
+
+    private:
+        struct Expected {
+            const char* data;
+            std::size_t size;
+        };
+
+        std::uint8_t count_ = 0;
+        std::array<Expected, capacity> expected_{};
+    };
+
+    // the value and the rest of the input on success, an Error on failure. it reads like the
+    // std::optional<std::pair<T, std::string_view>> it replaces. a success only zeroes the few words of an empty Error,
+    // so it costs about what it did before failures carried anything
     template <typename T>
-    using Result = std::optional<std::pair<T, std::string_view>>;
+    class Result {
+    public:
+        using value_type = std::pair<T, std::string_view>;
+
+        Result() = default;
+
+        Result(std::nullopt_t) noexcept {}
+
+        Result(const Error& error) noexcept : error_(error) {}
+
+        template <typename... Args>
+        explicit Result(std::in_place_t, Args&&... args) : value_(std::in_place, std::forward<Args>(args)...) {}
+
+        // U defaults to value_type so a braced {value, rest} picks this constructor
+        template <typename U = value_type>
+            requires std::constructible_from<value_type, U&&> &&
+                (!std::same_as<std::remove_cvref_t<U>, Result>) &&
+                (!std::same_as<std::remove_cvref_t<U>, Error>) &&
+                (!std::same_as<std::remove_cvref_t<U>, std::nullopt_t>)
+        Result(U&& value) : value_(std::forward<U>(value)) {}
+
+        // from the Result of a parser with a convertible value type, like the alternatives of a choice
+        template <typename U>
+            requires (!std::same_as<U, T>) && std::constructible_from<value_type, const std::pair<U, std::string_view>&>
+        Result(const Result<U>& other) : error_(other.error()) {
+            if (other) {
+                value_.emplace(*other);
+            }
+        }
+
+        template <typename U>
+            requires (!std::same_as<U, T>) && std::constructible_from<value_type, std::pair<U, std::string_view>&&>
+        Result(Result<U>&& other) : error_(other.error()) {
+            if (other) {
+                value_.emplace(std::move(*other));
+            }
+        }
+
+        auto has_value() const noexcept -> bool {
+            return value_.has_value();
+        }
+
+        explicit operator bool() const noexcept {
+            return value_.has_value();
+        }
+
+        auto operator*() & -> value_type& {
+            return *value_;
+        }
+
+        auto operator*() const& -> const value_type& {
+            return *value_;
+        }
+
+        auto operator*() && -> value_type&& {
+            return *std::move(value_);
+        }
+
+        auto operator->() -> value_type* {
+            return &*value_;
+        }
+
+        auto operator->() const -> const value_type* {
+            return &*value_;
+        }
+
+        auto value() & -> value_type& {
+            return *value_;
+        }
+
+        auto value() const& -> const value_type& {
+            return *value_;
+        }
+
+        auto value() && -> value_type&& {
+            return *std::move(value_);
+        }
+
+        // why the parse failed, with no position or expectations on success or when the parser did not report any
+        auto error() const -> const Error& {
+            return error_;
+        }
+
+    private:
+        std::optional<value_type> value_;
+        Error error_;
+    };
 
     template <typename P>
     using ParserResult = std::invoke_result_t<P, std::string_view>;
 
     template <typename P>
     using ParserValueType = ParserResult<P>::value_type::first_type;
+
+    // a string literal usable as a template argument, without its terminating null
+    template <std::size_t N>
+    struct FixedString {
+        std::array<char, N> chars{};
+
+        constexpr FixedString(const char (&literal)[N + 1]) {
+            for (std::size_t i = 0; i < N; ++i) {
+                chars[i] = literal[i];
+            }
+        }
+
+        constexpr auto view() const -> std::string_view {
+            return std::string_view(chars.data(), N);
+        }
+
+        static constexpr auto size() -> std::size_t {
+            return N;
+        }
+    };
+
+    template <std::size_t N>
+    FixedString(const char (&)[N]) -> FixedString<N - 1>;
     // #endregion
 
     // #region concepts
@@ -42,13 +231,64 @@ namespace pc {
     // #endregion
 
     // #region helpers
+    // value is moved from when it is an rvalue, so a parser can hand on a move-only value, like a std::unique_ptr node
     template <typename T>
-    Result<T> success(T&& value, std::string_view input) {
-        return {{std::forward<T>(value), input}};
+    auto success(T&& value, std::string_view input) -> Result<std::remove_cvref_t<T>> {
+        return Result<std::remove_cvref_t<T>>(std::in_place, std::forward<T>(value), input);
     }
 
+    // a failure without any Error information, prefer failure_at
     static constexpr const auto failure = std::nullopt;
 
-    bool is_digit(char c);
+    // a failure at the start of input, where expected would have matched. an empty expected records only the position
+    inline auto failure_at(std::string_view input, std::string_view expected = {}) -> Error {
+        Error error;
+        error.position = input.data();
+        if (!expected.empty()) {
+            error.expect(expected);
+        }
+        return error;
+    }
+
+    namespace detail {
+        // the end of the buffer an Incremental is parsing on this thread, and whether a parser has depended on it
+        struct EndWatch {
+            const char* end = nullptr;
+            bool reached = false;
+        };
+
+        inline thread_local EndWatch end_watch;
+    }
+
+    // tells an Incremental that the outcome on input depends on where input ends: a parser calls it where it runs out of
+    // input, or stops at its end, as more input there could change what it returns. a parser reading the input itself
+    // has to call it too, or a stream may cut its item short. it is only called where input runs out, and only compares
+    // a pointer
+    inline void reached_end(std::string_view input) {
+        if (input.data() + input.size() == detail::end_watch.end) {
+            detail::end_watch.reached = true;
+        }
+    }
+
+    namespace detail {
+        // one object for the whole program, so every translation unit names a character with the same pointer, which
+        // is what Error::expect compares
+        inline constexpr std::array<char, 256> all_bytes = [] {
+            std::array<char, 256> bytes{};
+            for (std::size_t i = 0; i < bytes.size(); ++i) {
+                bytes[i] = static_cast<char>(i);
+            }
+            return bytes;
+        }();
+    }
+
+    // c as a one byte string that lives as long as the program, to name an expected character
+    constexpr auto char_string(char c) -> std::string_view {
+        return std::string_view(&detail::all_bytes[static_cast<unsigned char>(c)], 1);
+    }
+
+    constexpr bool is_digit(char c) {
+        return c >= '0' && c <= '9';
+    }
     // #endregion
 }
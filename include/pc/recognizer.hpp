@@ -0,0 +1,85 @@
+#pragma once
+
+#include <pc/pc.hpp>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace pc {
+    // #region types
+    // the value of a parser run only for how much input it consumes, by ignore(parser) and by recognizers
+    struct Ignored {
+        constexpr auto operator==(const Ignored&) const -> bool = default;
+    };
+
+    // how a parser built on Recognizable runs: for its value, or only for what it consumes
+    struct Parsing {};
+    struct Recognizing {};
+
+    template <typename Mode>
+    inline constexpr bool recognizing = std::is_same_v<Mode, Recognizing>;
+
+    // the Result a parser of T gives in Mode
+    template <typename Mode, typename T>
+    using ModeResult = Result<std::conditional_t<recognizing<Mode>, Ignored, T>>;
+
+    // a parser with a second entry point, recognize, that consumes what the parser would and fails where it would
+    // without constructing a value. f is called as f(input, mode) and written once for both modes, so the parsers it
+    // captures are only stored once, and a grammar is only written once whether its values are needed or not
+    template <typename F>
+    class Recognizable {
+    public:
+        constexpr explicit Recognizable(F f) : f_(std::move(f)) {}
+
+        auto operator()(std::string_view input) const {
+            return std::invoke(f_, input, Parsing());
+        }
+
+        auto recognize(std::string_view input) const -> Result<Ignored> {
+            return std::invoke(f_, input, Recognizing());
+        }
+
+    private:
+        F f_;
+    };
+    // #endregion
+
+    // #region concepts
+    template <typename P>
+    concept HasRecognizer = AnyParser<P> &&
+        requires(const P& parser, std::string_view input) {
+            { parser.recognize(input) } -> std::same_as<Result<Ignored>>;
+        };
+    // #endregion
+
+    // #region helpers
+    template <typename F>
+    constexpr auto recognizable(F f) -> Recognizable<F> {
+        return Recognizable<F>(std::move(f));
+    }
+
+    // what parser consumes from input, through its recognizer where it has one, otherwise by parsing and dropping the
+    // value
+    auto skip(const AnyParser auto& parser, std::string_view input) -> Result<Ignored> {
+        if constexpr (HasRecognizer<std::remove_cvref_t<decltype(parser)>>) {
+            return parser.recognize(input);
+        } else {
+            auto result = std::invoke(parser, input);
+            if (!result) {
+                return result.error();
+            }
+            return success(Ignored(), result->second);
+        }
+    }
+
+    // parser run in mode, by the combinators running their parsers in their own mode
+    auto run(Parsing, const AnyParser auto& parser, std::string_view input) {
+        return std::invoke(parser, input);
+    }
+
+    auto run(Recognizing, const AnyParser auto& parser, std::string_view input) -> Result<Ignored> {
+        return skip(parser, input);
+    }
+    // #endregion
+} // namespace pc
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <pc/pc.hpp>
+#include <pc/char_class.hpp>
+#include <pc/erased_parser.hpp>
+#include <pc/first_set.hpp>
+#include <pc/recognizer.hpp>
+#include <pc/stack.hpp>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace pc {
+    // #region types
+    // rules nested in each other on the calling thread, whichever rules they are
+    inline thread_local std::size_t rule_depth = 0;
+
+    template <typename T>
+    class Rule;
+
+    // a reference to a Rule, which is what grammars hold in place of the rule itself. it is only as valid as the rule
+    template <typename T>
+    class RuleRef {
+    public:
+        explicit RuleRef(const Rule<T>& rule) : rule_(&rule) {}
+
+        auto operator()(std::string_view input) const -> Result<T> {
+            return (*rule_)(input);
+        }
+
+        auto recognize(std::string_view input) const -> Result<Ignored> {
+            return rule_->recognize(input);
+        }
+
+        auto first_set() const -> const CharClass& {
+            return rule_->first_set();
+        }
+
+    private:
+        const Rule<T>* rule_;
+    };
+
+    // a parser of T that can be used before it is defined, for grammars that refer to themselves, like the values of
+    // JSON nesting in arrays, or to each other. declare the rule, build the grammar with rule.ref() wherever the rule
+    // is needed, then define the rule with that grammar. calling a rule is one indirect call besides the depth and
+    // stack checks below, the definition being held by an ErasedParser the rule owns, and the rule cannot move as
+    // every reference points at it. the first set is declared along with the rule, as the grammars built on it are
+    // built before the definition that would tell it, and the definition must not succeed on other bytes. a rule
+    // declared without one has every byte in it, and one that is never defined fails on every input.
+    // a rule called with max_depth rules already nested on the thread fails, so untrusted input cannot nest without
+    // bound. where the input starts with a byte of its first set, the failure is a fatal Error, which no choice or
+    // repetition backtracks from, so the limit fails the whole parse rather than some other alternative taking over.
+    // however deep the nesting, the thread's stack does not overflow, as a rule called with little of it left runs on
+    // a stack of its own on the heap, see with_enough_stack
+    template <typename T>
+    class Rule {
+    public:
+        static constexpr std::size_t unlimited = std::numeric_limits<std::size_t>::max();
+
+        explicit Rule(CharClass first_set = any_first_set, std::size_t max_depth = unlimited)
+            : first_set_(first_set), max_depth_(max_depth) {}
+
+        Rule(const Rule&) = delete;
+        Rule& operator=(const Rule&) = delete;
+
+        // debug builds assert that a definition with a first set has no byte the rule was not declared with, as choice
+        // would never try the rule on it
+        template <typename P>
+            requires Parser<P, T>
+        void define(P parser) {
+#if PC_DEBUG
+            if constexpr (HasFirstSet<P>) {
+                assert((parser.first_set() & ~first_set_) == CharClass() && "Rule defined with bytes outside its declared first set");
+            }
+#endif
+            definition_ = ErasedParser<T>(std::move(parser));
+        }
+
+        auto ref() const -> RuleRef<T> {
+            return RuleRef<T>(*this);
+        }
+
+        auto operator()(std::string_view input) const -> Result<T> {
+            return nested(input, [this](std::string_view rest) {
+                return definition_(rest);
+            });
+        }
+
+        auto recognize(std::string_view input) const -> Result<Ignored> {
+            return nested(input, [this](std::string_view rest) {
+                return definition_.recognize(rest);
+            });
+        }
+
+        auto first_set() const -> const CharClass& {
+            return first_set_;
+        }
+
+        auto max_depth() const -> std::size_t {
+            return max_depth_;
+        }
+
+    private:
+        // one level deeper into the rules for the duration of parse, unless that is past the limit
+        template <typename Parse>
+        auto nested(std::string_view input, Parse parse) const -> std::invoke_result_t<Parse, std::string_view> {
+            if (rule_depth >= max_depth_) {
+                Error error = failure_at(input, "nesting within the depth limit");
+                // on any other byte the definition fails anyway, e.g. where a repetition of the rule ends
+                error.fatal = !input.empty() && first_set_.contains(input.front());
+                return error;
+            }
+            struct Level {
+                Level() {
+                    ++rule_depth;
+                }
+                Level(const Level&) = delete;
+                Level& operator=(const Level&) = delete;
+                ~Level() {
+                    --rule_depth;
+                }
+            } level;
+            return with_enough_stack([&parse, input]() {
+                return parse(input);
+            });
+        }
+
+        ErasedParser<T> definition_;
+        CharClass first_set_;
+        std::size_t max_depth_;
+    };
+    // #endregion
+} // namespace pc
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <pc/char_class.hpp>
+#include <cstddef>
+#include <string_view>
+
+namespace pc::simd {
+    // #region types
+    enum class Level {
+        scalar,
+        sse2,
+        ssse3,
+        avx2,
+    };
+    // #endregion
+
+    // #region helpers
+    // the widest instruction set the running CPU supports, detected once
+    auto level() -> Level;
+
+    // index of the first occurrence of c in input, or input.size() if there is none
+    auto find(std::string_view input, char c) -> std::size_t;
+
+    // length of the longest prefix of input made only of bytes in char_class
+    auto prefix_length(std::string_view input, const CharClass& char_class) -> std::size_t;
+
+    // length of the longest suffix of input made only of bytes in char_class
+    auto suffix_length(std::string_view input, const CharClass& char_class) -> std::size_t;
+    // #endregion
+} // namespace pc::simd
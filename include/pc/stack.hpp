@@ -0,0 +1,64 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace pc {
+    // #region types
+    // the least stack with_enough_stack leaves a call, and the size of the stacks it moves calls to once less is left
+    inline constexpr std::size_t stack_red_zone = 64 * 1024;
+    inline constexpr std::size_t stack_segment_size = 1024 * 1024;
+
+    // the lowest address the calling thread may use of the stack it runs on, 0 until remaining_stack() first looks
+    // it up, and 1 where the platform does not tell, which makes every check pass
+    inline thread_local std::uintptr_t stack_limit = 0;
+    // #endregion
+
+    // #region helpers
+    // bytes of stack the calling thread has left below the caller
+    auto remaining_stack() -> std::size_t;
+
+    // calls fn(context) on a new stack of size bytes allocated on the heap and returns once it has. fn must not throw.
+    // on platforms without ucontext, fn is called on the current stack
+    void call_on_new_stack(std::size_t size, void (*fn)(void*), void* context);
+
+    // fn(), moved to a new stack of stack_segment_size bytes on the heap once less than stack_red_zone is left of the
+    // current one, so recursion through it goes on where it would have overflowed the stack of the thread. checking
+    // is a comparison with the address of a local, exceptions thrown by fn are rethrown on the calling stack
+    template <std::invocable F>
+        requires (!std::is_void_v<std::invoke_result_t<F>>)
+    auto with_enough_stack(F&& fn) -> std::invoke_result_t<F> {
+        char marker = 0;
+        auto here = reinterpret_cast<std::uintptr_t>(&marker);
+        if (stack_limit != 0 && here - stack_limit >= stack_red_zone) {
+            return std::invoke(std::forward<F>(fn));
+        }
+        if (remaining_stack() >= stack_red_zone) {
+            return std::invoke(std::forward<F>(fn));
+        }
+
+        std::optional<std::invoke_result_t<F>> result;
+        std::exception_ptr exception;
+        auto call = [&fn, &result, &exception]() {
+            try {
+                result.emplace(std::invoke(std::forward<F>(fn)));
+            } catch (...) {
+                exception = std::current_exception();
+            }
+        };
+        call_on_new_stack(stack_segment_size, [](void* context) {
+            (*static_cast<decltype(call)*>(context))();
+        }, &call);
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+        return std::move(*result);
+    }
+    // #endregion
+} // namespace pc
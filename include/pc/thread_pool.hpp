@@ -0,0 +1,55 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pc {
+    // #region types
+    // a fixed set of worker threads, each with its own task queue. a worker runs its own newest task first and, once
+    // its queue is empty, steals the oldest task of another worker, so uneven work spreads out without a shared queue
+    class ThreadPool {
+    public:
+        explicit ThreadPool(std::size_t threads = std::max(1u, std::thread::hardware_concurrency()));
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+        ~ThreadPool();
+
+        auto size() const -> std::size_t {
+            return threads_.size();
+        }
+
+        void submit(std::function<void()> task);
+
+        // runs task(0) to task(count - 1) on the pool, the calling thread helping out, and returns once all are done.
+        // the first exception a task throws is rethrown then, the other tasks still run. safe to call from inside a task
+        void parallel_for(std::size_t count, const std::function<void(std::size_t)>& task);
+
+    private:
+        struct Queue {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        void work(std::size_t index);
+        // runs one task, from queue home if it has any or stolen from another queue, false if every queue is empty
+        auto run_one(std::size_t home) -> bool;
+        auto home() -> std::size_t;
+
+        std::vector<std::unique_ptr<Queue>> queues_;
+        std::vector<std::thread> threads_;
+        std::mutex sleep_mutex_;
+        std::condition_variable wake_;
+        std::atomic<std::size_t> pending_ = 0;
+        std::atomic<std::size_t> next_queue_ = 0;
+        bool stopping_ = false;
+    };
+    // #endregion
+} // namespace pc
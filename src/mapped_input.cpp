@@ -0,0 +1,97 @@
+#include <pc/mapped_input.hpp>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define PC_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define PC_HAS_MMAP 0
+#include <fstream>
+#include <memory>
+#endif
+
+namespace pc {
+    auto MappedInput::open(const std::filesystem::path& path) -> std::optional<MappedInput> {
+#if PC_HAS_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return std::nullopt;
+        }
+
+        struct stat status {};
+        if (::fstat(fd, &status) != 0 || !S_ISREG(status.st_mode)) {
+            ::close(fd);
+            return std::nullopt;
+        }
+
+        auto size = static_cast<std::size_t>(status.st_size);
+        if (size == 0) {
+            // mmap rejects empty mappings, an empty file is just empty input
+            ::close(fd);
+            return MappedInput(nullptr, 0, false);
+        }
+
+        void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        // the mapping keeps the file alive on its own
+        ::close(fd);
+        if (data == MAP_FAILED) {
+            return std::nullopt;
+        }
+
+        // parsers make one forward pass: read ahead aggressively and drop pages behind us early
+        ::madvise(data, size, MADV_SEQUENTIAL);
+        ::madvise(data, size, MADV_WILLNEED);
+        return MappedInput(static_cast<const char*>(data), size, false);
+#else
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            return std::nullopt;
+        }
+        auto size = static_cast<std::size_t>(file.tellg());
+        auto data = std::make_unique<char[]>(size);
+        file.seekg(0);
+        if (!file.read(data.get(), static_cast<std::streamsize>(size))) {
+            return std::nullopt;
+        }
+        return MappedInput(data.release(), size, true);
+#endif
+    }
+
+    MappedInput::MappedInput(MappedInput&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0)),
+          owned_(std::exchange(other.owned_, false)) {}
+
+    MappedInput& MappedInput::operator=(MappedInput&& other) noexcept {
+        if (this != &other) {
+            reset();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            owned_ = std::exchange(other.owned_, false);
+        }
+        return *this;
+    }
+
+    MappedInput::~MappedInput() {
+        reset();
+    }
+
+    void MappedInput::reset() {
+        if (data_ == nullptr) {
+            return;
+        }
+#if PC_HAS_MMAP
+        ::munmap(const_cast<char*>(data_), size_);
+#else
+        if (owned_) {
+            delete[] data_;
+        }
+#endif
+        data_ = nullptr;
+        size_ = 0;
+        owned_ = false;
+    }
+} // namespace pc
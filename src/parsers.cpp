@@ -1,28 +1,76 @@
 
 #include <pc/pc.hpp>
 #include <pc/combinators.hpp>
+#include <pc/parsers.hpp>
+#include <pc/simd.hpp>
 
 namespace pc::parsers {
     auto character(std::string_view input) -> Result<char> {
         if (input.empty()) {
-            return failure;
+            reached_end(input);
+            return failure_at(input, "a character");
         }
         return success(input[0], input.substr(1));
     }
 
     auto newline(std::string_view input) -> Result<char> {
-        return combinators::filter(character, [](char c) { return c == '\n'; })(input);
-    };
+        return tag('\n')(input);
+    }
 
-    auto line(std::string_view input) -> Result<std::string> {
+    auto line_view(std::string_view input) -> Result<std::string_view> {
         if (input.empty()) {
-            return failure;
+            reached_end(input);
+            return failure_at(input, "a line");
+        }
+
+        auto end = simd::find(input, '\n');
+        if (end == input.size()) {
+            reached_end(input);
+            return success(input, std::string_view());
+        }
+        return success(input.substr(0, end), input.substr(end + 1));
+    }
+
+    TagTrie::TagTrie(std::span<const std::string_view> tags) {
+        for (std::string_view tag : tags) {
+            for (char c : tag) {
+                auto& byte_class = classes_[static_cast<unsigned char>(c)];
+                if (byte_class == 0) {
+                    byte_class = static_cast<std::uint16_t>(width_++);
+                }
+            }
         }
 
-        auto it = std::find_if(input.begin(), input.end(), [](char c) { return c == '\n'; });
-        if (it == input.end()) {
-            return success(std::string(input), std::string_view());
+        // the root, then a node per distinct tag prefix
+        next_.assign(width_, 0);
+        accept_.assign(1, 0);
+        for (std::size_t index = 0; index < tags.size(); ++index) {
+            std::size_t node = 0;
+            for (char c : tags[index]) {
+                std::size_t edge = node * width_ + classes_[static_cast<unsigned char>(c)];
+                if (next_[edge] == 0) {
+                    next_[edge] = static_cast<std::uint32_t>(accept_.size());
+                    accept_.push_back(0);
+                    next_.resize(next_.size() + width_, 0);
+                }
+                node = next_[edge];
+            }
+            if (accept_[node] == 0) {
+                accept_[node] = index + 1;
+            }
+        }
+    }
+
+    auto TagTrie::first_set() const -> CharClass {
+        if (accept_[0] != 0) {
+            return any_first_set;
+        }
+        CharClass result;
+        for (std::size_t byte = 0; byte < classes_.size(); ++byte) {
+            if (classes_[byte] != 0 && next_[classes_[byte]] != 0) {
+                result.insert(static_cast<char>(byte));
+            }
         }
-        return success(std::string(input.begin(), it), std::string_view(it + 1, input.end()));
+        return result;
     }
 } // namespace pc::parsers
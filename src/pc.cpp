@@ -1,8 +0,0 @@
-
-#include <pc/pc.hpp>
-
-namespace pc {
-    bool is_digit(char c) {
-        return c >= '0' && c <= '9';
-    }
-} // namespace pc
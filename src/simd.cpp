@@ -0,0 +1,240 @@
+#include <pc/simd.hpp>
+#include <bit>
+#include <cstdint>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define PC_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define PC_SIMD_X86 0
+#endif
+
+namespace pc::simd {
+    namespace {
+        auto find_scalar(const char* data, std::size_t size, char c) -> std::size_t {
+            for (std::size_t i = 0; i < size; ++i) {
+                if (data[i] == c) {
+                    return i;
+                }
+            }
+            return size;
+        }
+
+        auto prefix_length_scalar(const char* data, std::size_t size, const CharClass& char_class) -> std::size_t {
+            std::size_t i = 0;
+            while (i < size && char_class.contains(data[i])) {
+                ++i;
+            }
+            return i;
+        }
+
+        auto suffix_length_scalar(const char* data, std::size_t size, const CharClass& char_class) -> std::size_t {
+            std::size_t i = size;
+            while (i > 0 && char_class.contains(data[i - 1])) {
+                --i;
+            }
+            return size - i;
+        }
+
+#if PC_SIMD_X86
+        __attribute__((target("sse2")))
+        auto find_sse2(const char* data, std::size_t size, char c) -> std::size_t {
+            const __m128i needle = _mm_set1_epi8(c);
+            std::size_t i = 0;
+            for (; i + 16 <= size; i += 16) {
+                const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+                if (mask != 0) {
+                    return i + static_cast<std::size_t>(std::countr_zero(mask));
+                }
+            }
+            return i + find_scalar(data + i, size - i, c);
+        }
+
+        __attribute__((target("avx2")))
+        auto find_avx2(const char* data, std::size_t size, char c) -> std::size_t {
+            const __m256i needle = _mm256_set1_epi8(c);
+            std::size_t i = 0;
+            for (; i + 32 <= size; i += 32) {
+                const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+                if (mask != 0) {
+                    return i + static_cast<std::size_t>(std::countr_zero(mask));
+                }
+            }
+            return i + find_sse2(data + i, size - i, c);
+        }
+
+        // the byte selecting bit (high nibble & 7) of a CharClass table entry, indexed by high nibble
+        constexpr std::uint8_t nibble_bits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+
+        // bit i of the result is set when byte i of block is NOT in the class, looking up the low nibble in the
+        // table half for the byte's top bit and testing the bit picked by the rest of its high nibble
+        __attribute__((target("ssse3")))
+        auto outside_mask_ssse3(__m128i block, __m128i low_table, __m128i high_table) -> std::uint32_t {
+            const __m128i nibble_mask = _mm_set1_epi8(0x0f);
+            const __m128i top_bit = _mm_set1_epi8(static_cast<char>(0x80));
+            const __m128i bits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(nibble_bits));
+            // pshufb zeroes lanes whose index has the top bit set, which picks the table half for us
+            const __m128i index = _mm_and_si128(block, _mm_or_si128(nibble_mask, top_bit));
+            const __m128i entry = _mm_or_si128(
+                _mm_shuffle_epi8(low_table, index),
+                _mm_shuffle_epi8(high_table, _mm_xor_si128(index, top_bit)));
+            const __m128i high_nibble = _mm_and_si128(_mm_srli_epi16(block, 4), nibble_mask);
+            const __m128i hit = _mm_and_si128(entry, _mm_shuffle_epi8(bits, high_nibble));
+            return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(hit, _mm_setzero_si128())));
+        }
+
+        __attribute__((target("avx2")))
+        auto outside_mask_avx2(__m256i block, __m256i low_table, __m256i high_table) -> std::uint32_t {
+            const __m256i nibble_mask = _mm256_set1_epi8(0x0f);
+            const __m256i top_bit = _mm256_set1_epi8(static_cast<char>(0x80));
+            const __m256i bits = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(nibble_bits)));
+            const __m256i index = _mm256_and_si256(block, _mm256_or_si256(nibble_mask, top_bit));
+            const __m256i entry = _mm256_or_si256(
+                _mm256_shuffle_epi8(low_table, index),
+                _mm256_shuffle_epi8(high_table, _mm256_xor_si256(index, top_bit)));
+            const __m256i high_nibble = _mm256_and_si256(_mm256_srli_epi16(block, 4), nibble_mask);
+            const __m256i hit = _mm256_and_si256(entry, _mm256_shuffle_epi8(bits, high_nibble));
+            return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hit, _mm256_setzero_si256())));
+        }
+
+        __attribute__((target("ssse3")))
+        auto prefix_length_ssse3(const char* data, std::size_t size, const CharClass& char_class) -> std::size_t {
+            const __m128i low_table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(char_class.table.data()));
+            const __m128i high_table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(char_class.table.data() + 16));
+            std::size_t i = 0;
+            for (; i + 16 <= size; i += 16) {
+                const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                if (auto mask = outside_mask_ssse3(block, low_table, high_table); mask != 0) {
+                    return i + static_cast<std::size_t>(std::countr_zero(mask));
+                }
+            }
+            return i + prefix_length_scalar(data + i, size - i, char_class);
+        }
+
+        __attribute__((target("ssse3")))
+        auto suffix_length_ssse3(const char* data, std::size_t size, const CharClass& char_class) -> std::size_t {
+            const __m128i low_table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(char_class.table.data()));
+            const __m128i high_table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(char_class.table.data() + 16));
+            std::size_t i = size;
+            for (; i >= 16; i -= 16) {
+                const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i - 16));
+                if (auto mask = outside_mask_ssse3(block, low_table, high_table) << 16; mask != 0) {
+                    return size - i + static_cast<std::size_t>(std::countl_zero(mask));
+                }
+            }
+            return size - i + suffix_length_scalar(data, i, char_class);
+        }
+
+        __attribute__((target("avx2")))
+        auto prefix_length_avx2(const char* data, std::size_t size, const CharClass& char_class) -> std::size_t {
+            const __m256i low_table = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(char_class.table.data())));
+            const __m256i high_table = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(char_class.table.data() + 16)));
+            std::size_t i = 0;
+            for (; i + 32 <= size; i += 32) {
+                const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                if (auto mask = outside_mask_avx2(block, low_table, high_table); mask != 0) {
+                    return i + static_cast<std::size_t>(std::countr_zero(mask));
+                }
+            }
+            return i + prefix_length_ssse3(data + i, size - i, char_class);
+        }
+
+        __attribute__((target("avx2")))
+        auto suffix_length_avx2(const char* data, std::size_t size, const CharClass& char_class) -> std::size_t {
+            const __m256i low_table = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(char_class.table.data())));
+            const __m256i high_table = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(char_class.table.data() + 16)));
+            std::size_t i = size;
+            for (; i >= 32; i -= 32) {
+                const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i - 32));
+                if (auto mask = outside_mask_avx2(block, low_table, high_table); mask != 0) {
+                    return size - i + static_cast<std::size_t>(std::countl_zero(mask));
+                }
+            }
+            return size - i + suffix_length_ssse3(data, i, char_class);
+        }
+#endif
+
+        auto detect_level() -> Level {
+#if PC_SIMD_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2")) {
+                return Level::avx2;
+            }
+            if (__builtin_cpu_supports("ssse3")) {
+                return Level::ssse3;
+            }
+            if (__builtin_cpu_supports("sse2")) {
+                return Level::sse2;
+            }
+#endif
+            return Level::scalar;
+        }
+
+        using FindFn = auto (*)(const char*, std::size_t, char) -> std::size_t;
+        using SpanFn = auto (*)(const char*, std::size_t, const CharClass&) -> std::size_t;
+
+        auto select_find() -> FindFn {
+            switch (level()) {
+#if PC_SIMD_X86
+                case Level::avx2: return find_avx2;
+                case Level::ssse3: return find_sse2;
+                case Level::sse2: return find_sse2;
+#endif
+                default: return find_scalar;
+            }
+        }
+
+        auto select_prefix_length() -> SpanFn {
+            switch (level()) {
+#if PC_SIMD_X86
+                case Level::avx2: return prefix_length_avx2;
+                case Level::ssse3: return prefix_length_ssse3;
+#endif
+                default: return prefix_length_scalar;
+            }
+        }
+
+        auto select_suffix_length() -> SpanFn {
+            switch (level()) {
+#if PC_SIMD_X86
+                case Level::avx2: return suffix_length_avx2;
+                case Level::ssse3: return suffix_length_ssse3;
+#endif
+                default: return suffix_length_scalar;
+            }
+        }
+    }
+
+    auto level() -> Level {
+        static const Level detected = detect_level();
+        return detected;
+    }
+
+    auto find(std::string_view input, char c) -> std::size_t {
+        // lines are often shorter than a vector, where the dispatch is not worth it
+        if (input.size() < 16) {
+            return find_scalar(input.data(), input.size(), c);
+        }
+        static const FindFn fn = select_find();
+        return fn(input.data(), input.size(), c);
+    }
+
+    auto prefix_length(std::string_view input, const CharClass& char_class) -> std::size_t {
+        // most runs end within the first few bytes, check those before paying for the table loads
+        if (input.size() < 16 || !char_class.contains(input[0]) || !char_class.contains(input[1])) {
+            return prefix_length_scalar(input.data(), input.size(), char_class);
+        }
+        static const SpanFn fn = select_prefix_length();
+        return fn(input.data(), input.size(), char_class);
+    }
+
+    auto suffix_length(std::string_view input, const CharClass& char_class) -> std::size_t {
+        if (input.size() < 16 || !char_class.contains(input[input.size() - 1]) || !char_class.contains(input[input.size() - 2])) {
+            return suffix_length_scalar(input.data(), input.size(), char_class);
+        }
+        static const SpanFn fn = select_suffix_length();
+        return fn(input.data(), input.size(), char_class);
+    }
+} // namespace pc::simd
@@ -0,0 +1,121 @@
+#include <pc/stack.hpp>
+#include <limits>
+#include <memory>
+#include <new>
+#include <utility>
+
+#if defined(__linux__) && defined(__GLIBC__)
+#define PC_HAS_UCONTEXT 1
+#include <pthread.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+#else
+#define PC_HAS_UCONTEXT 0
+#endif
+
+namespace pc {
+#if PC_HAS_UCONTEXT
+    namespace {
+        // a stack mapped from the heap, with a page below it left inaccessible so an overflow faults rather than
+        // overwriting whatever is mapped there
+        class Segment {
+        public:
+            explicit Segment(std::size_t size) {
+                auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+                size_ = (size + page - 1) / page * page + page;
+                void* memory = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+                if (memory == MAP_FAILED) {
+                    throw std::bad_alloc();
+                }
+                memory_ = static_cast<char*>(memory);
+                ::mprotect(memory_, page, PROT_NONE);
+                bottom_ = memory_ + page;
+            }
+
+            Segment(const Segment&) = delete;
+            Segment& operator=(const Segment&) = delete;
+
+            ~Segment() {
+                ::munmap(memory_, size_);
+            }
+
+            // the usable part of the segment, above the guard page
+            auto bottom() const -> char* {
+                return bottom_;
+            }
+
+            auto usable_size() const -> std::size_t {
+                return static_cast<std::size_t>(memory_ + size_ - bottom_);
+            }
+
+        private:
+            char* memory_ = nullptr;
+            char* bottom_ = nullptr;
+            std::size_t size_ = 0;
+        };
+
+        // the call being started on a new stack, as makecontext only passes ints to the function it starts
+        struct Call {
+            void (*fn)(void*);
+            void* context;
+        };
+
+        thread_local Call* starting = nullptr;
+        // a segment kept from the last call that returned, so a parse going back and forth across the edge of the
+        // stack maps one segment rather than one per call
+        thread_local std::unique_ptr<Segment> spare;
+
+        void start() {
+            Call* call = starting;
+            call->fn(call->context);
+        }
+    }
+
+    auto remaining_stack() -> std::size_t {
+        if (stack_limit == 0) {
+            pthread_attr_t attributes;
+            void* address = nullptr;
+            std::size_t size = 0;
+            if (::pthread_getattr_np(::pthread_self(), &attributes) == 0) {
+                ::pthread_attr_getstack(&attributes, &address, &size);
+                ::pthread_attr_destroy(&attributes);
+            }
+            stack_limit = address != nullptr ? reinterpret_cast<std::uintptr_t>(address) : 1;
+        }
+        char marker = 0;
+        auto here = reinterpret_cast<std::uintptr_t>(&marker);
+        return here > stack_limit ? here - stack_limit : 0;
+    }
+
+    void call_on_new_stack(std::size_t size, void (*fn)(void*), void* context) {
+        std::unique_ptr<Segment> segment = spare && spare->usable_size() >= size ? std::move(spare) : std::make_unique<Segment>(size);
+
+        ucontext_t caller;
+        ucontext_t callee;
+        ::getcontext(&callee);
+        callee.uc_stack.ss_sp = segment->bottom();
+        callee.uc_stack.ss_size = segment->usable_size();
+        callee.uc_link = &caller;
+        ::makecontext(&callee, start, 0);
+
+        Call call{fn, context};
+        starting = &call;
+        std::uintptr_t limit = stack_limit;
+        stack_limit = reinterpret_cast<std::uintptr_t>(segment->bottom());
+        ::swapcontext(&caller, &callee);
+        stack_limit = limit;
+
+        spare = std::move(segment);
+    }
+#else
+    auto remaining_stack() -> std::size_t {
+        stack_limit = 1;
+        return std::numeric_limits<std::size_t>::max();
+    }
+
+    void call_on_new_stack(std::size_t, void (*fn)(void*), void* context) {
+        fn(context);
+    }
+#endif
+} // namespace pc
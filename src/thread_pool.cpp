@@ -0,0 +1,123 @@
+#include <pc/thread_pool.hpp>
+#include <exception>
+#include <latch>
+
+namespace pc {
+    namespace {
+        // the pool and queue the current thread works for, if it is a worker
+        thread_local const ThreadPool* current_pool = nullptr;
+        thread_local std::size_t current_queue = 0;
+    }
+
+    ThreadPool::ThreadPool(std::size_t threads) {
+        threads = std::max<std::size_t>(threads, 1);
+        for (std::size_t i = 0; i < threads; ++i) {
+            queues_.push_back(std::make_unique<Queue>());
+        }
+        for (std::size_t i = 0; i < threads; ++i) {
+            threads_.emplace_back([this, i] { work(i); });
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard lock(sleep_mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    void ThreadPool::submit(std::function<void()> task) {
+        {
+            // counted before it is published, as a worker stealing it decrements pending_ as soon as it is taken. both
+            // under sleep_mutex_, so a woken worker finds the task in place
+            std::lock_guard sleep_lock(sleep_mutex_);
+            ++pending_;
+            Queue& queue = *queues_[home()];
+            std::lock_guard lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+        wake_.notify_one();
+    }
+
+    void ThreadPool::parallel_for(std::size_t count, const std::function<void(std::size_t)>& task) {
+        std::latch done(static_cast<std::ptrdiff_t>(count));
+        // an exception leaving a worker would terminate the program, so the first one waits here for the caller
+        std::exception_ptr error;
+        std::mutex error_mutex;
+        for (std::size_t i = 0; i < count; ++i) {
+            submit([&task, &done, &error, &error_mutex, i] {
+                try {
+                    task(i);
+                } catch (...) {
+                    std::lock_guard lock(error_mutex);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                }
+                done.count_down();
+            });
+        }
+
+        // help rather than block, which also keeps a task waiting on nested work from starving the pool
+        std::size_t queue = home();
+        while (!done.try_wait()) {
+            if (!run_one(queue)) {
+                done.wait();
+                break;
+            }
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    void ThreadPool::work(std::size_t index) {
+        current_pool = this;
+        current_queue = index;
+        while (true) {
+            if (run_one(index)) {
+                continue;
+            }
+            std::unique_lock lock(sleep_mutex_);
+            wake_.wait(lock, [this] { return stopping_ || pending_ > 0; });
+            if (stopping_ && pending_ == 0) {
+                return;
+            }
+        }
+    }
+
+    auto ThreadPool::run_one(std::size_t home) -> bool {
+        std::function<void()> task;
+        for (std::size_t i = 0; i < queues_.size() && !task; ++i) {
+            Queue& queue = *queues_[(home + i) % queues_.size()];
+            std::lock_guard lock(queue.mutex);
+            if (queue.tasks.empty()) {
+                continue;
+            }
+            if (i == 0) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            } else {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+        }
+        if (!task) {
+            return false;
+        }
+        --pending_;
+        task();
+        return true;
+    }
+
+    auto ThreadPool::home() -> std::size_t {
+        if (current_pool == this) {
+            return current_queue;
+        }
+        return next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    }
+} // namespace pc
@@ -2,11 +2,21 @@
 #include <pc/pc.hpp>
 #include <pc/parsers.hpp>
 #include <pc/combinators.hpp>
+#include <pc/arena.hpp>
+#include <pc/inline_vector.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
 #include <ranges>
 #include <string>
 #include <string_view>
+#include <tuple>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace pc {
     using namespace combinators;
@@ -14,6 +24,42 @@ namespace pc {
 }
 using namespace std::literals::string_view_literals;
 
+namespace {
+    // counts its copies, so the tests can tell a combinator handing a value on from one duplicating it
+    struct Counted {
+        static inline std::size_t copies = 0;
+
+        char c = 0;
+
+        Counted() = default;
+        explicit Counted(char value) : c(value) {}
+        Counted(const Counted& other) : c(other.c) {
+            ++copies;
+        }
+        Counted(Counted&&) noexcept = default;
+        auto operator=(const Counted& other) -> Counted& {
+            c = other.c;
+            ++copies;
+            return *this;
+        }
+        auto operator=(Counted&&) noexcept -> Counted& = default;
+    };
+
+    auto counted(std::string_view input) -> pc::Result<Counted> {
+        if (input.empty()) {
+            return pc::failure_at(input);
+        }
+        return pc::success(Counted(input[0]), input.substr(1));
+    }
+
+    auto boxed(std::string_view input) -> pc::Result<std::unique_ptr<char>> {
+        if (input.empty()) {
+            return pc::failure_at(input);
+        }
+        return pc::success(std::make_unique<char>(input[0]), input.substr(1));
+    }
+}
+
 TEST_CASE("manyn", "[combinators]") {
     SECTION("manyn<0> with empty input, no match") {
         const auto result = pc::manyn<0>(pc::tag("hello"))("");
@@ -140,6 +186,42 @@ TEST_CASE("trim", "[combinators]") {
         CHECK(result->first == " \n \t  "sv);
         CHECK(result->second == "hello \n\t "sv);
     }
+
+    SECTION("trim with input that needs trimming longer than a vector register, match") {
+        const std::string padding(70, ' ');
+        const auto result = pc::trim(pc::tag("hello"))(padding + "hello" + padding);
+        REQUIRE(result);
+        CHECK(result->first == "hello"sv);
+        CHECK(result->second == ""sv);
+    }
+
+    SECTION("trim with a custom whitespace set") {
+        const auto result = pc::trim(pc::tag("hello"), pc::CharClass(" ,"))(" , hello,, ");
+        REQUIRE(result);
+        CHECK(result->first == "hello"sv);
+        CHECK(result->second == ""sv);
+    }
+}
+
+TEST_CASE("trim_left", "[combinators]") {
+    SECTION("trim_left with input that needs trimming, match") {
+        const auto result = pc::trim_left(pc::tag("hello"))(" \n \t  hello \n\t ");
+        REQUIRE(result);
+        CHECK(result->first == "hello"sv);
+        CHECK(result->second == " \n\t "sv);
+    }
+
+    SECTION("trim_left with input that needs trimming, no match") {
+        const auto result = pc::trim_left(pc::tag("hello"))("   \n\t world");
+        REQUIRE(!result);
+    }
+
+    SECTION("trim_left with a custom whitespace set") {
+        const auto result = pc::trim_left(pc::tag("hello"), pc::CharClass(","))(",,hello,,");
+        REQUIRE(result);
+        CHECK(result->first == "hello"sv);
+        CHECK(result->second == ",,"sv);
+    }
 }
 
 TEST_CASE("choice", "[combinators]") {
@@ -494,6 +576,22 @@ TEST_CASE("many_split_by0", "[combinators]") {
         const auto result = pc::many_split_by0(pc::tag("hello"), "\n")("\n\n");
         REQUIRE(!result);
     }
+
+    SECTION("3 matches, split to 3 by a multi character seperator, non empty input") {
+        const auto result = pc::many_split_by0(pc::tag("hello"), ", ")("hello, hello, hello");
+        REQUIRE(result);
+        CHECK(result->first == std::vector<std::string>{"hello", "hello", "hello"});
+        CHECK(result->second == ""sv);
+    }
+
+    SECTION("splits longer than a vector register") {
+        const std::string line(40, 'a');
+        const std::string input = line + "\n" + line + "\n" + line;
+        const auto result = pc::many_split_by0(pc::tag_view(line), "\n")(input);
+        REQUIRE(result);
+        CHECK(result->first == std::vector<std::string_view>{line, line, line});
+        CHECK(result->second == ""sv);
+    }
 }
 
 TEST_CASE("many_split_by1", "[combinators]") {
@@ -568,6 +666,306 @@ TEST_CASE("many_split_by1", "[combinators]") {
     }
 }
 
+TEST_CASE("par_many_split_by0", "[combinators]") {
+    pc::ThreadPool pool(4);
+
+    SECTION("agrees with many_split_by0 for every chunk size") {
+        std::string input;
+        for (int i = 0; i < 200; ++i) {
+            input += std::string(static_cast<std::size_t>(i % 7), 'a') + "\n";
+        }
+        const auto expected = pc::many_split_by0(pc::take_while0(pc::CharClass("a")), "\n")(input);
+        REQUIRE(expected);
+        for (std::size_t min_chunk_size : std::array<std::size_t, 6>{1, 2, 5, 64, 1000, 100000}) {
+            const auto result = pc::par_many_split_by0(pc::take_while0(pc::CharClass("a")), "\n", pool, min_chunk_size)(input);
+            REQUIRE(result);
+            CHECK(result->first == expected->first);
+            CHECK(result->second == ""sv);
+        }
+    }
+
+    SECTION("multi character seperator") {
+        const auto result = pc::par_many_split_by0(pc::tag("hello"), ", ", pool, 1)("hello, hello, hello, hello");
+        REQUIRE(result);
+        CHECK(result->first == std::vector<std::string>{"hello", "hello", "hello", "hello"});
+        CHECK(result->second == ""sv);
+    }
+
+    SECTION("empty segments at chunk boundaries") {
+        const auto result = pc::par_many_split_by0(pc::tag(""), "\n", pool, 1)("\n\n\n");
+        REQUIRE(result);
+        CHECK(result->first == std::vector<std::string>{"", "", "", ""});
+    }
+
+    SECTION("self overlapping seperator splits like many_split_by0") {
+        const auto result = pc::par_many_split_by0(pc::take_while0(pc::CharClass("ab")), "aa", pool, 1)("aaab");
+        REQUIRE(result);
+        CHECK(result->first == std::vector<std::string_view>{"", "ab"});
+    }
+
+    SECTION("one failing segment fails the whole parse") {
+        std::string input;
+        for (int i = 0; i < 1000; ++i) {
+            input += i == 937 ? "world\n" : "hello\n";
+        }
+        input += "hello";
+        CHECK(!pc::par_many_split_by0(pc::tag("hello"), "\n", pool, 16)(input));
+    }
+
+    SECTION("empty input") {
+        CHECK(!pc::par_many_split_by0(pc::tag("hello"), "\n", pool, 1)(""));
+        const auto result = pc::par_many_split_by0(pc::tag(""), "\n", pool, 1)("");
+        REQUIRE(result);
+        CHECK(result->first == std::vector<std::string>{""});
+    }
+}
+
+TEST_CASE("par_many_split_by1", "[combinators]") {
+    pc::ThreadPool pool(2);
+
+    SECTION("3 matches, split to 3") {
+        const auto result = pc::par_many_split_by1(pc::tag("hello"), "\n", pool, 1)("hello\nhello\nhello");
+        REQUIRE(result);
+        CHECK(result->first == std::vector<std::string>{"hello", "hello", "hello"});
+    }
+
+    SECTION("2 matches, split to 3") {
+        CHECK(!pc::par_many_split_by1(pc::tag("hello"), "\n", pool, 1)("hello\nworld\nhello"));
+    }
+}
+
+namespace {
+    struct CountingResource : std::pmr::memory_resource {
+        std::size_t allocations = 0;
+
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+            ++allocations;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    };
+}
+
+TEST_CASE("repetition with a memory resource", "[combinators]") {
+    CountingResource resource;
+
+    SECTION("many0 allocates the vector and its strings from the resource") {
+        const auto result = pc::many0(pc::pmr::tag("ab", &resource), &resource)("ababab!");
+        REQUIRE(result);
+        CHECK(result->first == std::pmr::vector<std::pmr::string>{"ab", "ab", "ab"});
+        CHECK(result->first.get_allocator().resource() == &resource);
+        CHECK(result->first[0].get_allocator().resource() == &resource);
+        CHECK(result->second == "!"sv);
+        CHECK(resource.allocations > 0);
+    }
+
+    SECTION("many1 fails without a match") {
+        const auto result = pc::many1(pc::tag('a'), &resource)("bbb");
+        REQUIRE(!result);
+    }
+
+    SECTION("many_seperated_by0 allocates from the resource") {
+        const auto result = pc::many_seperated_by0(pc::tag('a'), pc::tag(','), &resource)("a,a,a");
+        REQUIRE(result);
+        CHECK(result->first == std::pmr::vector<char>{'a', 'a', 'a'});
+        CHECK(result->first.get_allocator().resource() == &resource);
+        CHECK(result->second == ""sv);
+    }
+
+    SECTION("many_split_by0 allocates nested vectors from the resource") {
+        const auto result = pc::many_split_by0(pc::many0(pc::tag('a'), &resource), "\n", &resource)("aa\na\n");
+        REQUIRE(result);
+        REQUIRE(result->first.size() == 3);
+        CHECK(result->first[0].size() == 2);
+        CHECK(result->first[1].size() == 1);
+        CHECK(result->first[2].empty());
+        CHECK(result->first[0].get_allocator().resource() == &resource);
+    }
+
+    SECTION("a parse scoped arena serves small parses from its inline buffer") {
+        pc::Arena<4096> arena(&resource);
+        const auto result = pc::many_split_by0(pc::pmr::line(arena), "\n", arena)("hello\nworld");
+        REQUIRE(result);
+        CHECK(result->first == std::pmr::vector<std::pmr::string>{"hello", "world"});
+        CHECK(resource.allocations == 0);
+    }
+
+    SECTION("a parse scoped arena falls back to upstream once its inline buffer is used up") {
+        pc::Arena<64> arena(&resource);
+        const auto result = pc::many0(pc::character, arena)(std::string(1000, 'a'));
+        REQUIRE(result);
+        CHECK(result->first.size() == 1000);
+        CHECK(resource.allocations > 0);
+    }
+}
+
+TEST_CASE("repetition into a sink", "[combinators]") {
+    SECTION("an inline vector") {
+        const auto parser = pc::many0(pc::tag('!'), pc::InlineVector<char, 4>());
+        static_assert(std::is_same_v<pc::ParserValueType<decltype(parser)>, pc::InlineVector<char, 4>>);
+        const auto result = parser("!!!x"sv);
+        REQUIRE(result);
+        CHECK(result->first == pc::InlineVector<char, 4>{'!', '!', '!'});
+        CHECK(result->first.is_inline());
+        CHECK(result->second == "x"sv);
+    }
+
+    SECTION("every parse starts from a copy of the sink") {
+        const auto parser = pc::many1(pc::character, pc::InlineVector<char, 2>{'>'});
+        CHECK(parser("ab"sv)->first == pc::InlineVector<char, 2>{'>', 'a', 'b'});
+        CHECK(parser("c"sv)->first == pc::InlineVector<char, 2>{'>', 'c'});
+        CHECK(!parser(""sv));
+    }
+
+    SECTION("an output iterator into a vector reused across parses") {
+        std::vector<char> values;
+        values.reserve(16);
+        const auto parser = pc::many_seperated_by1(pc::character, pc::tag(','), std::back_inserter(values));
+        REQUIRE(parser("a,b,c"sv));
+        CHECK(values == std::vector{'a', 'b', 'c'});
+
+        values.clear();
+        REQUIRE(parser("d"sv));
+        CHECK(values == std::vector{'d'});
+        CHECK(values.capacity() == 16);
+    }
+
+    SECTION("the value is the output iterator past the last value") {
+        std::array<int, 4> values{};
+        const auto result = pc::many_seperated_by0(pc::integer<int>(), pc::tag(','), values.begin())("1,2,3"sv);
+        REQUIRE(result);
+        CHECK(result->first == values.begin() + 3);
+        CHECK(values == std::array{1, 2, 3, 0});
+    }
+
+    SECTION("split repetitions") {
+        const auto result = pc::many_split_by1(pc::line_view, "\n", pc::InlineVector<std::string_view, 2>())("a\nb\nc"sv);
+        REQUIRE(result);
+        CHECK(result->first == pc::InlineVector<std::string_view, 2>{"a"sv, "b"sv, "c"sv});
+        CHECK(!result->first.is_inline());
+    }
+
+    SECTION("recognizing writes nothing") {
+        std::vector<char> values;
+        const auto result = pc::recognize(pc::many0(pc::character, std::back_inserter(values)))("abc"sv);
+        REQUIRE(result);
+        CHECK(result->first == "abc"sv);
+        CHECK(values.empty());
+    }
+}
+
+TEST_CASE("many0_fold", "[combinators]") {
+    const auto count = [](int n, char) { return n + 1; };
+    const auto digit_sum = [](int sum, char c) { return sum + (c - '0'); };
+    const auto digit = pc::filter(pc::character, pc::is_digit);
+
+    SECTION("matching 0 times, empty input, gives init") {
+        const auto result = pc::many0_fold(pc::tag('a'), 0, count)("");
+        REQUIRE(result);
+        CHECK(result->first == 0);
+        CHECK(result->second == ""sv);
+    }
+
+    SECTION("matching 0 times, non empty input, gives init") {
+        const auto result = pc::many0_fold(pc::tag('a'), 10, count)("bbb");
+        REQUIRE(result);
+        CHECK(result->first == 10);
+        CHECK(result->second == "bbb"sv);
+    }
+
+    SECTION("matching 3 times, non empty input") {
+        const auto result = pc::many0_fold(digit, 0, digit_sum)("123abc");
+        REQUIRE(result);
+        CHECK(result->first == 6);
+        CHECK(result->second == "abc"sv);
+    }
+
+    SECTION("every parse starts from init") {
+        const auto parser = pc::many0_fold(digit, 0, digit_sum);
+        CHECK(parser("99")->first == 18);
+        CHECK(parser("99")->first == 18);
+    }
+
+    SECTION("accumulator of a different type") {
+        const auto result = pc::many0_fold(pc::line_view, std::string(), [](std::string s, std::string_view line) {
+            return s + std::string(line);
+        })("a\nb\nc");
+        REQUIRE(result);
+        CHECK(result->first == "abc");
+    }
+}
+
+TEST_CASE("many1_fold", "[combinators]") {
+    const auto count = [](int n, char) { return n + 1; };
+
+    SECTION("matching 0 times fails") {
+        const auto result = pc::many1_fold(pc::tag('a'), 0, count)("bbb");
+        REQUIRE(!result);
+    }
+
+    SECTION("matching 1 times") {
+        const auto result = pc::many1_fold(pc::tag('a'), 0, count)("abb");
+        REQUIRE(result);
+        CHECK(result->first == 1);
+        CHECK(result->second == "bb"sv);
+    }
+
+    SECTION("matching 3 times") {
+        const auto result = pc::many1_fold(pc::tag('a'), 0, count)("aaab");
+        REQUIRE(result);
+        CHECK(result->first == 3);
+        CHECK(result->second == "b"sv);
+    }
+}
+
+TEST_CASE("many_seperated_by0_fold", "[combinators]") {
+    const auto count = [](int n, const std::string&) { return n + 1; };
+
+    SECTION("matching 0 times gives init") {
+        const auto result = pc::many_seperated_by0_fold(pc::tag("hello"), pc::tag(','), 0, count)("world");
+        REQUIRE(result);
+        CHECK(result->first == 0);
+        CHECK(result->second == "world"sv);
+    }
+
+    SECTION("matching 3 times") {
+        const auto result = pc::many_seperated_by0_fold(pc::tag("hello"), pc::tag(','), 0, count)("hello,hello,hello");
+        REQUIRE(result);
+        CHECK(result->first == 3);
+        CHECK(result->second == ""sv);
+    }
+
+    SECTION("matching 1 times then matching seperator, leaves the seperator") {
+        const auto result = pc::many_seperated_by0_fold(pc::tag("hello"), pc::tag(','), 0, count)("hello,world");
+        REQUIRE(result);
+        CHECK(result->first == 1);
+        CHECK(result->second == ",world"sv);
+    }
+}
+
+TEST_CASE("many_seperated_by1_fold", "[combinators]") {
+    const auto count = [](int n, const std::string&) { return n + 1; };
+
+    SECTION("matching 0 times fails") {
+        const auto result = pc::many_seperated_by1_fold(pc::tag("hello"), pc::tag(','), 0, count)("world");
+        REQUIRE(!result);
+    }
+
+    SECTION("matching 3 times") {
+        const auto result = pc::many_seperated_by1_fold(pc::tag("hello"), pc::tag(','), 0, count)("hello,hello,hello,");
+        REQUIRE(result);
+        CHECK(result->first == 3);
+        CHECK(result->second == ","sv);
+    }
+}
+
 // pair works with different types
 static_assert(requires {
     pc::pair(pc::tag("hello"), pc::tag("world"));
@@ -762,6 +1160,107 @@ TEST_CASE("tuple", "[combinators]") {
             REQUIRE(!result);
         }
     }
+
+    SECTION("tuple(p1, p2, p3) with move-only values") {
+        const auto parser = pc::tuple(boxed, pc::tag('-'), boxed);
+        const auto result = parser("a-b"sv);
+        REQUIRE(result);
+        CHECK(*std::get<0>(result->first) == 'a');
+        CHECK(std::get<1>(result->first) == '-');
+        CHECK(*std::get<2>(result->first) == 'b');
+    }
+}
+
+TEST_CASE("ignore", "[combinators]") {
+    static_assert(std::is_same_v<pc::ParserValueType<decltype(pc::ignore(pc::tag("hello")))>, pc::Ignored>);
+
+    SECTION("tuple leaves ignored values out") {
+        const auto parser = pc::tuple(pc::tag_view("key"), pc::ignore(pc::tag('=')), pc::character, pc::ignore(pc::tag(';')));
+        static_assert(std::is_same_v<pc::ParserValueType<decltype(parser)>, std::tuple<std::string_view, char>>);
+        const auto result = parser("key=v;rest"sv);
+        REQUIRE(result);
+        CHECK(result->first == std::tuple{"key"sv, 'v'});
+        CHECK(result->second == "rest"sv);
+    }
+
+    SECTION("an ignored parser still has to match") {
+        constexpr auto input = "key:v;"sv;
+        const auto result = pc::tuple(pc::tag_view("key"), pc::ignore(pc::tag('=')), pc::character)(input);
+        REQUIRE(!result);
+        CHECK(result.error().offset(input) == 3);
+        CHECK(result.error().expected(0) == "="sv);
+    }
+
+    SECTION("a tuple of ignored values only") {
+        const auto result = pc::tuple(pc::ignore(pc::tag('a')), pc::ignore(pc::tag('b')))("abc"sv);
+        REQUIRE(result);
+        CHECK(result->first == std::tuple<>());
+        CHECK(result->second == "c"sv);
+    }
+
+    SECTION("ignore keeps the first set") {
+        CHECK(pc::ignore(pc::tag('a')).first_set() == pc::CharClass("a"));
+        CHECK(pc::tuple(pc::ignore(pc::tag('a')), pc::character).first_set() == pc::CharClass("a"));
+    }
+}
+
+TEST_CASE("preceded", "[combinators]") {
+    SECTION("match") {
+        const auto result = pc::preceded(pc::tag('-'), pc::tag_view("value"))("-value!"sv);
+        REQUIRE(result);
+        CHECK(result->first == "value"sv);
+        CHECK(result->second == "!"sv);
+    }
+
+    SECTION("the prefix fails") {
+        constexpr auto input = "+value"sv;
+        const auto result = pc::preceded(pc::tag('-'), pc::tag_view("value"))(input);
+        REQUIRE(!result);
+        CHECK(result.error().offset(input) == 0);
+    }
+
+    SECTION("the parser fails") {
+        constexpr auto input = "-other"sv;
+        const auto result = pc::preceded(pc::tag('-'), pc::tag_view("value"))(input);
+        REQUIRE(!result);
+        CHECK(result.error().offset(input) == 1);
+    }
+}
+
+TEST_CASE("terminated", "[combinators]") {
+    SECTION("match") {
+        const auto result = pc::terminated(pc::tag_view("value"), pc::tag(';'))("value;rest"sv);
+        REQUIRE(result);
+        CHECK(result->first == "value"sv);
+        CHECK(result->second == "rest"sv);
+    }
+
+    SECTION("the suffix fails") {
+        constexpr auto input = "value,"sv;
+        const auto result = pc::terminated(pc::tag_view("value"), pc::tag(';'))(input);
+        REQUIRE(!result);
+        CHECK(result.error().offset(input) == 5);
+        CHECK(result.error().expected(0) == ";"sv);
+    }
+}
+
+TEST_CASE("delimited", "[combinators]") {
+    const auto parser = pc::delimited(pc::tag('('), pc::take_while1(pc::char_classes::alpha), pc::tag(')'));
+
+    SECTION("match") {
+        const auto result = parser("(word) rest"sv);
+        REQUIRE(result);
+        CHECK(result->first == "word"sv);
+        CHECK(result->second == " rest"sv);
+        CHECK(parser.first_set() == pc::CharClass("("));
+    }
+
+    SECTION("unclosed") {
+        constexpr auto input = "(word"sv;
+        const auto result = parser(input);
+        REQUIRE(!result);
+        CHECK(result.error().offset(input) == 5);
+    }
 }
 
 TEST_CASE("map", "[combinators]") {
@@ -849,3 +1348,270 @@ TEST_CASE("filter", "[combinators]") {
         REQUIRE(!result);
     }
 }
+
+TEST_CASE("recognize", "[combinators]") {
+    static_assert(pc::HasRecognizer<decltype(pc::many0(pc::tag("a")))>);
+    static_assert(pc::HasRecognizer<decltype(pc::line)>);
+    static_assert(!pc::HasRecognizer<decltype(pc::filter(pc::character, [](char) { return true; }))>);
+
+    std::size_t calls = 0;
+    const auto grammar = pc::many_seperated_by1(
+        pc::map(pc::delimited(pc::tag('('), pc::many1(pc::choice(pc::tag("ab"), pc::tag("c"))), pc::tag(')')), [&calls](auto v) {
+            ++calls;
+            return v.size();
+        }),
+        pc::tag(','));
+
+    SECTION("the value is the input the grammar consumes") {
+        constexpr auto input = "(ab),(cabc),(c)rest"sv;
+        const auto parsed = grammar(input);
+        REQUIRE(parsed);
+        CHECK(calls == 3);
+
+        const auto result = pc::recognize(grammar)(input);
+        REQUIRE(result);
+        CHECK(result->first == "(ab),(cabc),(c)"sv);
+        CHECK(result->second == parsed->second);
+        CHECK(calls == 3);
+    }
+
+    SECTION("failing where the grammar fails") {
+        constexpr auto input = "(ab),(x)"sv;
+        const auto parsed = pc::many1(grammar)("(a"sv);
+        const auto result = pc::recognize(pc::many1(grammar))("(a"sv);
+        REQUIRE(!parsed);
+        REQUIRE(!result);
+        CHECK(result.error().offset("(a"sv) == parsed.error().offset("(a"sv));
+        CHECK(result.error().expected(0) == parsed.error().expected(0));
+
+        CHECK(pc::recognize(grammar)(input)->first == "(ab)"sv);
+        CHECK(calls == 0);
+    }
+
+    SECTION("recognizing the whole input of a split repetition") {
+        const auto result = pc::recognize(pc::many_split_by0(pc::line, "\n"))("hello\nworld"sv);
+        REQUIRE(result);
+        CHECK(result->first == "hello\nworld"sv);
+        CHECK(result->second == ""sv);
+    }
+
+    SECTION("recognize keeps the first set and is recognizable itself") {
+        CHECK(pc::recognize(pc::tag('a')).first_set() == pc::CharClass("a"));
+        const auto result = pc::many0(pc::recognize(pc::pair(pc::tag('a'), pc::character)))("abacd"sv);
+        REQUIRE(result);
+        CHECK(result->first == std::vector{"ab"sv, "ac"sv});
+        CHECK(result->second == "d"sv);
+    }
+}
+
+TEST_CASE("failure positions", "[combinators]") {
+    SECTION("choice merges the expectations of alternatives failing at the same position") {
+        constexpr auto input = "gamma"sv;
+        const auto result = pc::choice(pc::tag("alpha"), pc::tag("beta"), pc::tag("alpha"))(input);
+        REQUIRE(!result);
+        CHECK(result.error().offset(input) == 0);
+        REQUIRE(result.error().count() == 2);
+        CHECK(result.error().expected(0) == "alpha"sv);
+        CHECK(result.error().expected(1) == "beta"sv);
+    }
+
+    SECTION("choice keeps the alternative that got furthest") {
+        constexpr auto input = "key:value"sv;
+        const auto result = pc::choice(
+            pc::map(pc::pair(pc::tag("key"), pc::tag('=')), [](auto) { return 0; }),
+            pc::map(pc::tag("other"), [](auto) { return 0; }))(input);
+        REQUIRE(!result);
+        CHECK(result.error().offset(input) == 3);
+        REQUIRE(result.error().count() == 1);
+        CHECK(result.error().expected(0) == "="sv);
+    }
+
+    SECTION("choice drops expectations beyond capacity") {
+        const auto result = pc::choice(pc::tag("a"), pc::tag("b"), pc::tag("c"), pc::tag("d"))("x"sv);
+        REQUIRE(!result);
+        CHECK(result.error().count() == pc::Error::capacity);
+    }
+
+    SECTION("choice reports nothing once an alternative matches") {
+        const auto result = pc::choice(pc::tag("alpha"), pc::tag("beta"))("beta"sv);
+        REQUIRE(result);
+        CHECK(result.error().count() == 0);
+    }
+
+    SECTION("tuple reports where the failing element started") {
+        constexpr auto input = "hexlo"sv;
+        const auto result = pc::tuple(pc::tag('h'), pc::character, pc::tag("llo"))(input);
+        REQUIRE(!result);
+        CHECK(result.error().offset(input) == 2);
+        CHECK(result.error().expected(0) == "llo"sv);
+    }
+
+    SECTION("many_split_by0 expects the seperator where a segment is left unconsumed") {
+        constexpr auto input = "hello\nhelloworld\nhello"sv;
+        const auto result = pc::many_split_by0(pc::tag("hello"), "\n")(input);
+        REQUIRE(!result);
+        CHECK(result.error().offset(input) == 11);
+        CHECK(result.error().expected(0) == "\n"sv);
+    }
+
+    SECTION("many_split_by0 reports the failing segment") {
+        constexpr auto input = "hello, hello, world"sv;
+        const auto result = pc::many_split_by0(pc::tag("hello"), ", ")(input);
+        REQUIRE(!result);
+        CHECK(result.error().offset(input) == 14);
+        CHECK(result.error().expected(0) == "hello"sv);
+    }
+
+    SECTION("par_many_split_by0 reports the first failing segment") {
+        pc::ThreadPool pool(4);
+        std::string input;
+        for (int i = 0; i < 1000; ++i) {
+            input += i == 300 || i == 700 ? "world\n" : "hello\n";
+        }
+        input += "hello";
+        const auto result = pc::par_many_split_by0(pc::tag("hello"), "\n", pool, 16)(input);
+        REQUIRE(!result);
+        CHECK(result.error().offset(input) == 300 * 6);
+    }
+
+    SECTION("filter fails where the value started") {
+        constexpr auto input = "aB"sv;
+        const auto result = pc::filter(pc::character, [](char c) { return c >= 'a' && c <= 'z'; })(input.substr(1));
+        REQUIRE(!result);
+        CHECK(result.error().offset(input) == 1);
+    }
+
+    SECTION("many1_fold reports why the first item failed") {
+        constexpr auto input = "x"sv;
+        const auto result = pc::many1_fold(pc::tag('a'), 0, [](int n, char) { return n + 1; })(input);
+        REQUIRE(!result);
+        CHECK(result.error().offset(input) == 0);
+        CHECK(result.error().expected(0) == "a"sv);
+    }
+}
+
+TEST_CASE("first sets", "[combinators]") {
+    static_assert(pc::HasFirstSet<decltype(pc::tag("hello"))>);
+    static_assert(pc::HasFirstSet<decltype(pc::pair(pc::tag('k'), pc::character))>);
+    static_assert(!pc::HasFirstSet<decltype(pc::pair(pc::character, pc::tag('k')))>);
+    static_assert(!pc::HasFirstSet<decltype(pc::choice(pc::tag('k'), pc::character))>);
+
+    SECTION("parsers tell the bytes they can start with") {
+        CHECK(pc::tag("hello").first_set() == pc::CharClass("h"));
+        CHECK(pc::tag_view("hello").first_set() == pc::CharClass("h"));
+        CHECK(pc::tag('h').first_set() == pc::CharClass("h"));
+        CHECK(pc::tag("").first_set() == pc::any_first_set);
+        CHECK(pc::take_while1(pc::char_classes::digit).first_set() == pc::char_classes::digit);
+    }
+
+    SECTION("combinators derive theirs") {
+        CHECK(pc::pair(pc::tag("key"), pc::tag('=')).first_set() == pc::CharClass("k"));
+        CHECK(pc::tuple(pc::tag('h'), pc::character).first_set() == pc::CharClass("h"));
+        CHECK(pc::map(pc::tag('h'), [](char) { return 0; }).first_set() == pc::CharClass("h"));
+        CHECK(pc::choice(pc::tag("alpha"), pc::tag("beta")).first_set() == pc::CharClass("ab"));
+    }
+
+    SECTION("choice only tries the alternatives that can match the first byte") {
+        std::size_t calls = 0;
+        const auto counted = [&calls](char c) {
+            return pc::with_first_set([&calls, c](std::string_view input) {
+                ++calls;
+                return pc::tag(c)(input);
+            }, pc::CharClass(std::string_view(&c, 1)));
+        };
+        const auto parser = pc::choice(counted('a'), counted('b'), counted('c'), counted('d'));
+        const auto result = parser("dab"sv);
+        REQUIRE(result);
+        CHECK(result->first == 'd');
+        CHECK(calls == 1);
+    }
+
+    SECTION("choice keeps the order of alternatives sharing a first byte") {
+        const auto result = pc::choice(pc::tag("ab"), pc::tag("abc"), pc::tag("b"))("abc"sv);
+        REQUIRE(result);
+        CHECK(result->first == "ab");
+        CHECK(result->second == "c"sv);
+    }
+
+    SECTION("choice still tries alternatives without a first set") {
+        const auto parser = pc::choice(pc::tag('a'), pc::map(pc::character, [](char) { return 'x'; }), pc::tag('c'));
+        CHECK(parser("cab"sv)->first == 'x');
+        CHECK(parser("abc"sv)->first == 'a');
+    }
+
+    SECTION("choice reports every alternative when none can match") {
+        constexpr auto input = "gamma"sv;
+        const auto result = pc::choice(pc::tag("alpha"), pc::tag("beta"))(input);
+        REQUIRE(!result);
+        CHECK(result.error().offset(input) == 0);
+        REQUIRE(result.error().count() == 2);
+        const auto expected = std::pair{result.error().expected(0), result.error().expected(1)};
+        CHECK((expected == std::pair{"alpha"sv, "beta"sv} || expected == std::pair{"beta"sv, "alpha"sv}));
+    }
+
+    SECTION("a failing choice tries every alternative once") {
+        std::size_t calls = 0;
+        const auto counted = [&calls](std::string_view prefix) {
+            return pc::with_first_set([&calls, prefix](std::string_view input) {
+                ++calls;
+                return pc::tag(prefix)(input);
+            }, pc::CharClass(prefix.substr(0, 1)));
+        };
+        const auto parser = pc::choice(counted("ab"), counted("cd"), counted("ax"));
+        constexpr auto input = "ay"sv;
+        const auto result = parser(input);
+        REQUIRE(!result);
+        CHECK(calls == 3);
+        CHECK(result.error().offset(input) == 0);
+        CHECK(result.error().count() == 3);
+    }
+
+    SECTION("choice on empty input") {
+        CHECK(!pc::choice(pc::tag("alpha"), pc::tag("beta"))(""sv));
+        CHECK(pc::choice(pc::tag("alpha"), pc::tag(""))(""sv));
+    }
+}
+
+TEST_CASE("moves", "[combinators]") {
+    Counted::copies = 0;
+
+    SECTION("values are moved through every combinator") {
+        const auto parser = pc::many0(pc::map(
+            pc::pair(pc::tuple(pc::manyn<2>(counted), pc::filter(counted, [](const Counted& x) { return x.c != '!'; })),
+                pc::choice(pc::seperated_pair(counted, pc::tag(','), counted), pc::pair(counted, counted))),
+            [](auto p) { return std::pair{std::move(p.second), std::move(p.first)}; }));
+        const auto result = parser("abcd,eabcdef"sv);
+        REQUIRE(result);
+        CHECK(result->first.size() == 2);
+        CHECK(result->first[1].first.first.c == 'd');
+        CHECK(Counted::copies == 0);
+    }
+
+    SECTION("folds move each value into step") {
+        const auto parser = pc::many_seperated_by1_fold(counted, pc::tag(','), std::size_t{0}, [](std::size_t n, Counted) { return n + 1; });
+        CHECK(parser("a,b,c"sv)->first == 3);
+        CHECK(Counted::copies == 0);
+    }
+
+    SECTION("the split repetitions move each value into the vector") {
+        const auto result = pc::many_split_by0(counted, "\n")("a\nb\nc"sv);
+        REQUIRE(result);
+        CHECK(result->first.size() == 3);
+        CHECK(Counted::copies == 0);
+    }
+
+    SECTION("move-only values") {
+        const auto parser = pc::many1(pc::map(pc::pair(boxed, pc::choice(boxed, pc::fail<std::unique_ptr<char>>)), [](auto p) {
+            return std::move(p.second);
+        }));
+        const auto result = parser("abcd"sv);
+        REQUIRE(result);
+        REQUIRE(result->first.size() == 2);
+        CHECK(*result->first[0] == 'b');
+        CHECK(*result->first[1] == 'd');
+
+        const auto values = pc::many0_fold(pc::filter(boxed, [](const auto& x) { return *x != 'z'; }), std::string(),
+            [](std::string s, std::unique_ptr<char> x) { return s + *x; });
+        CHECK(values("xyz"sv)->first == "xy");
+    }
+}
@@ -0,0 +1,147 @@
+#include <pc/pc.hpp>
+#include <pc/parsers.hpp>
+#include <pc/combinators.hpp>
+#include <pc/erased_parser.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace pc {
+    using namespace combinators;
+    using namespace parsers;
+}
+using namespace std::literals::string_view_literals;
+
+namespace {
+    // a parser too large for the inline storage, with a tag of its own to tell it apart
+    struct LargeParser {
+        std::array<char, 256> padding{};
+        std::string_view tag;
+
+        auto operator()(std::string_view input) const -> pc::Result<std::string_view> {
+            return pc::tag_view(tag)(input);
+        }
+    };
+}
+
+TEST_CASE("ErasedParser", "[erased_parser]") {
+    static_assert(pc::Parser<pc::ErasedParser<int>, int>);
+
+    SECTION("parses like the parser it holds") {
+        const pc::ErasedParser<std::string_view> parser = pc::tag_view("hello");
+        const auto result = parser("hello world"sv);
+        REQUIRE(result);
+        CHECK(result->first == "hello"sv);
+        CHECK(result->second == " world"sv);
+
+        constexpr auto input = "goodbye"sv;
+        const auto failure = parser(input);
+        REQUIRE(!failure);
+        CHECK(failure.error().offset(input) == 0);
+        CHECK(failure.error().expected(0) == "hello"sv);
+    }
+
+    SECTION("parsers of different types in one container") {
+        const std::vector<pc::ErasedParser<int>> parsers = {
+            pc::integer<int>(),
+            pc::map(pc::tag('x'), [](char) { return -1; }),
+            pc::map(LargeParser{{}, "z"}, [](std::string_view) { return 26; }),
+        };
+        CHECK(parsers[0]("42"sv)->first == 42);
+        CHECK(parsers[1]("x"sv)->first == -1);
+        CHECK(!parsers[1]("42"sv));
+        CHECK(parsers[2]("z"sv)->first == 26);
+    }
+
+    SECTION("a default constructed parser fails") {
+        constexpr auto input = "anything"sv;
+        const auto result = pc::ErasedParser<char>()(input);
+        REQUIRE(!result);
+        CHECK(result.error().offset(input) == 0);
+    }
+
+    SECTION("parsers too large for the inline storage") {
+        pc::ErasedParser<std::string_view> parser = LargeParser{{}, "big"};
+        CHECK(parser("big"sv)->first == "big"sv);
+
+        pc::ErasedParser<std::string_view> copy = parser;
+        pc::ErasedParser<std::string_view> moved = std::move(parser);
+        CHECK(copy("big"sv));
+        CHECK(moved("big"sv));
+
+        moved = pc::tag_view("small");
+        CHECK(moved("small"sv));
+        copy = moved;
+        CHECK(copy("small"sv));
+        CHECK(!copy("big"sv));
+    }
+
+    SECTION("a parser moved from fails") {
+        pc::ErasedParser<std::string_view> parser = LargeParser{{}, "big"};
+        pc::ErasedParser<std::string_view> moved = std::move(parser);
+        constexpr auto input = "big"sv;
+        const auto result = parser(input);
+        REQUIRE(!result);
+        CHECK(result.error().offset(input) == 0);
+        CHECK(!pc::skip(parser, input));
+
+        pc::ErasedParser<std::string_view> copy = parser;
+        CHECK(!copy(input));
+        CHECK(moved(input));
+
+        // stored inline, the moved from trie of one_of_tags would be a null pointer
+        pc::ErasedParser<std::size_t> methods = pc::one_of_tags({"GET", "POST"});
+        pc::ErasedParser<std::size_t> moved_methods = std::move(methods);
+        CHECK(!methods("POST"sv));
+        CHECK(!pc::skip(methods, "POST"sv));
+        CHECK(methods.first_set() == pc::any_first_set);
+        CHECK(moved_methods("POST"sv)->first == 1);
+
+        pc::ErasedParser<std::size_t> assigned;
+        assigned = std::move(moved_methods);
+        CHECK(!moved_methods("GET"sv));
+        CHECK(assigned("GET"sv)->first == 0);
+    }
+
+    SECTION("copies copy the parser, destruction destroys it") {
+        auto shared = std::make_shared<int>(7);
+        pc::ErasedParser<int> parser = [shared](std::string_view input) -> pc::Result<int> {
+            return pc::success(*shared, input);
+        };
+        {
+            pc::ErasedParser<int> copy = parser;
+            CHECK(shared.use_count() == 3);
+        }
+        CHECK(shared.use_count() == 2);
+        CHECK(parser(""sv)->first == 7);
+    }
+
+    SECTION("keeps the first set, so choice still dispatches on it") {
+        const pc::ErasedParser<std::string_view> a = pc::tag_view("a");
+        const pc::ErasedParser<std::string_view> b = pc::tag_view("b");
+        CHECK(a.first_set() == pc::CharClass("a"));
+        CHECK(pc::ErasedParser<char>(pc::character).first_set() == pc::any_first_set);
+        CHECK(pc::choice(a, b).first_set() == pc::CharClass("ab"));
+        CHECK(pc::choice(a, b)("b"sv)->first == "b"sv);
+    }
+
+    SECTION("keeps the recognizer") {
+        std::size_t calls = 0;
+        const pc::ErasedParser<std::size_t> parser = pc::map(pc::many0(pc::tag("ab")), [&calls](auto values) {
+            ++calls;
+            return values.size();
+        });
+        static_assert(pc::HasRecognizer<pc::ErasedParser<std::size_t>>);
+        const auto result = pc::recognize(parser)("ababc"sv);
+        REQUIRE(result);
+        CHECK(result->first == "abab"sv);
+        CHECK(calls == 0);
+        CHECK(parser("ababc"sv)->first == 2);
+        CHECK(calls == 1);
+    }
+}
@@ -0,0 +1,142 @@
+#include <pc/pc.hpp>
+#include <pc/parsers.hpp>
+#include <pc/combinators.hpp>
+#include <pc/expression.hpp>
+#include <pc/rule.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace pc {
+    using namespace combinators;
+    using namespace parsers;
+}
+using namespace std::literals::string_view_literals;
+
+namespace {
+    // an expression over names, its value the expression again with every operator in parentheses, so the
+    // tests can read off how it grouped
+    auto grouping() {
+        auto binary = [](char op) {
+            return [op](std::string lhs, std::string rhs) { return "(" + lhs + op + rhs + ")"; };
+        };
+        return pc::expression(
+            pc::map(pc::take_while1(pc::char_classes::alpha), [](std::string_view name) { return std::string(name); }),
+            pc::infix(pc::tag('+'), 1, pc::Associativity::left, binary('+')),
+            pc::infix(pc::tag('-'), 1, pc::Associativity::left, binary('-')),
+            pc::infix(pc::tag('*'), 2, pc::Associativity::left, binary('*')),
+            pc::infix(pc::tag('^'), 4, pc::Associativity::right, binary('^')),
+            pc::prefix(pc::tag('-'), 3, [](std::string operand) { return "(-" + operand + ")"; }),
+            pc::postfix(pc::tag('!'), 5, [](std::string operand) { return "(" + operand + "!)"; }));
+    }
+
+    auto arithmetic(pc::AnyParser auto primary) {
+        return pc::expression(
+            primary,
+            pc::infix(pc::tag('+'), 1, pc::Associativity::left, [](long lhs, long rhs) { return lhs + rhs; }),
+            pc::infix(pc::tag('-'), 1, pc::Associativity::left, [](long lhs, long rhs) { return lhs - rhs; }),
+            pc::infix(pc::tag('*'), 2, pc::Associativity::left, [](long lhs, long rhs) { return lhs * rhs; }),
+            pc::prefix(pc::tag('-'), 3, [](long operand) { return -operand; }));
+    }
+}
+
+TEST_CASE("expression", "[expression]") {
+    SECTION("precedence and associativity") {
+        const auto parser = grouping();
+        CHECK(parser("a+b*c"sv)->first == "(a+(b*c))");
+        CHECK(parser("a*b+c"sv)->first == "((a*b)+c)");
+        CHECK(parser("a-b-c"sv)->first == "((a-b)-c)");
+        CHECK(parser("a^b^c"sv)->first == "(a^(b^c))");
+        CHECK(parser("a*b^c*d"sv)->first == "((a*(b^c))*d)");
+        CHECK(parser("a+b*c^d-e"sv)->first == "((a+(b*(c^d)))-e)");
+    }
+
+    SECTION("prefix and postfix operators") {
+        const auto parser = grouping();
+        CHECK(parser("-a"sv)->first == "(-a)");
+        CHECK(parser("--a"sv)->first == "(-(-a))");
+        CHECK(parser("-a*b"sv)->first == "((-a)*b)");
+        CHECK(parser("-a^b"sv)->first == "(-(a^b))");
+        CHECK(parser("-a!"sv)->first == "(-(a!))");
+        CHECK(parser("a!!^b"sv)->first == "(((a!)!)^b)");
+        CHECK(parser("a-b"sv)->first == "(a-b)");
+        CHECK(parser("a--b"sv)->first == "(a-(-b))");
+    }
+
+    SECTION("a lone primary term") {
+        const auto result = grouping()("a;"sv);
+        REQUIRE(result);
+        CHECK(result->first == "a");
+        CHECK(result->second == ";"sv);
+    }
+
+    SECTION("stops before the first byte that continues no expression") {
+        const auto result = grouping()("a+b)c"sv);
+        REQUIRE(result);
+        CHECK(result->first == "(a+b)");
+        CHECK(result->second == ")c"sv);
+    }
+
+    SECTION("an operator has to be followed by an operand") {
+        constexpr auto input = "a+b*"sv;
+        const auto result = grouping()(input);
+        REQUIRE(!result);
+        CHECK(result.error().offset(input) == 4);
+
+        constexpr auto empty = ""sv;
+        const auto nothing = grouping()(empty);
+        REQUIRE(!nothing);
+        CHECK(nothing.error().offset(empty) == 0);
+    }
+
+    SECTION("parentheses through a Rule") {
+        pc::Rule<long> expression(pc::CharClass("-(0123456789"));
+        expression.define(arithmetic(pc::choice(
+            pc::integer<long>(),
+            pc::delimited(pc::tag('('), expression.ref(), pc::tag(')')))));
+
+        CHECK(expression("1+2*3"sv)->first == 7);
+        CHECK(expression("(1+2)*3"sv)->first == 9);
+        CHECK(expression("10-4-3"sv)->first == 3);
+        CHECK(expression("-(2-5)*-2"sv)->first == -6);
+        CHECK(!expression("(1+2"sv));
+    }
+
+    SECTION("long chains of operators need neither recursion nor grammar layers") {
+        const auto parser = arithmetic(pc::integer<long>());
+        std::string sum = "1";
+        std::string negated = "1";
+        for (std::size_t i = 0; i < 100000; ++i) {
+            sum += "+1";
+            negated.insert(0, 1, '-');
+        }
+        CHECK(parser(sum)->first == 100001);
+        // the prefix operators all wait on the stack for the one operand at the end
+        CHECK(parser(negated)->first == 1);
+    }
+
+    SECTION("the first set is the one of the primary and the prefix operators") {
+        const auto parser = arithmetic(pc::integer<long>());
+        CHECK(parser.first_set() == (pc::CharClass("-") | pc::char_classes::digit));
+    }
+
+    SECTION("recognizes without calling the operators") {
+        std::size_t calls = 0;
+        const auto parser = pc::expression(
+            pc::integer<int>(),
+            pc::infix(pc::tag('+'), 1, pc::Associativity::left, [&calls](int lhs, int rhs) {
+                ++calls;
+                return lhs + rhs;
+            }),
+            pc::prefix(pc::tag('-'), 2, [&calls](int operand) {
+                ++calls;
+                return -operand;
+            }));
+        const auto result = pc::recognize(parser)("-1+2+-3;"sv);
+        REQUIRE(result);
+        CHECK(result->first == "-1+2+-3"sv);
+        CHECK(calls == 0);
+        CHECK(!pc::recognize(parser)("1+"sv));
+    }
+}
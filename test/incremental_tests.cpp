@@ -0,0 +1,204 @@
+#include <pc/pc.hpp>
+#include <pc/parsers.hpp>
+#include <pc/combinators.hpp>
+#include <pc/incremental.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace pc {
+    using namespace combinators;
+    using namespace parsers;
+}
+using namespace std::literals::string_view_literals;
+
+namespace {
+    // feeds input in chunks of chunk_size, collecting every item until the stream ends or fails
+    template <pc::AnyParser Parser>
+    auto items_in_chunks(Parser parser, std::string_view input, std::size_t chunk_size) -> std::vector<pc::ParserValueType<Parser>> {
+        auto items = pc::incremental(parser);
+        std::vector<pc::ParserValueType<Parser>> result;
+        while (true) {
+            auto step = items.next();
+            if (step.status == pc::Status::success) {
+                result.push_back(*step.value);
+            } else if (step.status == pc::Status::incomplete) {
+                if (input.empty()) {
+                    items.finish();
+                } else {
+                    auto chunk = input.substr(0, chunk_size);
+                    input.remove_prefix(chunk.size());
+                    items.feed(chunk);
+                }
+            } else {
+                break;
+            }
+        }
+        return result;
+    }
+}
+
+TEST_CASE("incremental", "[incremental]") {
+    SECTION("no input is incomplete until finished") {
+        auto lines = pc::incremental(pc::line_view);
+        CHECK(lines.next().status == pc::Status::incomplete);
+        lines.finish();
+        CHECK(lines.next().status == pc::Status::end);
+    }
+
+    SECTION("an item running to the end of the buffer is incomplete until more input arrives") {
+        auto lines = pc::incremental(pc::line_view);
+        lines.feed("hel");
+        CHECK(lines.next().status == pc::Status::incomplete);
+        lines.feed("lo\nwor");
+        auto step = lines.next();
+        REQUIRE(step.status == pc::Status::success);
+        CHECK(step.value == "hello"sv);
+        CHECK(step.offset == 6);
+        CHECK(lines.next().status == pc::Status::incomplete);
+    }
+
+    SECTION("the last item is parsed once finished") {
+        auto lines = pc::incremental(pc::line_view);
+        lines.feed("hello\nworld");
+        CHECK(lines.next().value == "hello"sv);
+        CHECK(lines.next().status == pc::Status::incomplete);
+        lines.finish();
+        auto step = lines.next();
+        REQUIRE(step.status == pc::Status::success);
+        CHECK(step.value == "world"sv);
+        CHECK(step.offset == 11);
+        CHECK(lines.next().status == pc::Status::end);
+    }
+
+    SECTION("consumed input is dropped from the buffer") {
+        auto lines = pc::incremental(pc::line_view);
+        lines.feed("hello\nwor");
+        CHECK(lines.next().status == pc::Status::success);
+        lines.feed("ld");
+        CHECK(lines.pending() == "world"sv);
+        CHECK(lines.offset() == 6);
+    }
+
+    SECTION("a failure before the end of the buffer is final") {
+        auto hellos = pc::incremental(pc::tag_view("hello"));
+        hellos.feed("hellohelp");
+        CHECK(hellos.next().status == pc::Status::success);
+        auto step = hellos.next();
+        CHECK(step.status == pc::Status::rejected);
+        CHECK(step.offset == 5);
+    }
+
+    SECTION("a failure running into the end of the buffer is incomplete until finished") {
+        auto hellos = pc::incremental(pc::tag_view("hello"));
+        hellos.feed("hellohel");
+        CHECK(hellos.next().status == pc::Status::success);
+        CHECK(hellos.next().status == pc::Status::incomplete);
+        hellos.finish();
+        auto step = hellos.next();
+        CHECK(step.status == pc::Status::rejected);
+        CHECK(step.offset == 5);
+    }
+
+    SECTION("a success that looked at the end of the buffer is incomplete until more input arrives") {
+        auto keywords = pc::incremental(pc::one_of_tags({"a", "abc"}));
+        keywords.feed("ab");
+        CHECK(keywords.next().status == pc::Status::incomplete);
+        keywords.feed("c!");
+        auto step = keywords.next();
+        REQUIRE(step.status == pc::Status::success);
+        CHECK(step.value == 1u);
+
+        auto tags = pc::incremental(pc::choice(pc::tag_view("abc"), pc::tag_view("a")));
+        tags.feed("ab");
+        CHECK(tags.next().status == pc::Status::incomplete);
+        tags.feed("ca");
+        CHECK(tags.next().value == "abc"sv);
+        CHECK(tags.next().status == pc::Status::incomplete);
+        tags.feed("x");
+        CHECK(tags.next().value == "a"sv);
+    }
+
+    SECTION("an incomplete item is parsed again once its buffered bytes have doubled") {
+        std::size_t parses = 0;
+        auto words = pc::incremental([&parses](std::string_view input) {
+            ++parses;
+            return pc::terminated(pc::take_while1(pc::char_classes::alpha), pc::tag('\n'))(input);
+        });
+        words.feed("ab");
+        CHECK(words.next().status == pc::Status::incomplete);
+        CHECK(words.next().status == pc::Status::incomplete);
+        CHECK(parses == 1);
+
+        words.feed("c");
+        CHECK(words.next().status == pc::Status::incomplete);
+        CHECK(parses == 1);
+        words.feed("d");
+        CHECK(words.next().status == pc::Status::incomplete);
+        CHECK(parses == 2);
+
+        // complete, but not yet parsed again
+        words.feed("\n");
+        CHECK(words.next().status == pc::Status::incomplete);
+        CHECK(parses == 2);
+        words.finish();
+        CHECK(words.next().value == "abcd"sv);
+        CHECK(parses == 3);
+
+        // an item fed 16 bytes at a time is parsed a number of times logarithmic in its size, rather than once a chunk
+        std::string item(100000, 'x');
+        item.push_back('\n');
+        parses = 0;
+        const auto word_size = [&parses](std::string_view input) {
+            ++parses;
+            return pc::map(pc::terminated(pc::take_while1(pc::char_classes::alpha), pc::tag('\n')), [](std::string_view word) {
+                return word.size();
+            })(input);
+        };
+        CHECK(items_in_chunks(word_size, item, 16) == std::vector<std::size_t>{100000});
+        CHECK(parses <= 20);
+    }
+
+    SECTION("input that can not start an item fails without being buffered") {
+        auto hellos = pc::incremental(pc::tag_view("hello"));
+        hellos.feed("x");
+        CHECK(hellos.next().status == pc::Status::rejected);
+    }
+
+    SECTION("a failure is final once the item in flight outgrows max_token_size") {
+        auto lines = pc::incremental(pc::line_view, 5);
+        lines.feed("hel");
+        CHECK(lines.next().status == pc::Status::incomplete);
+        lines.feed("lo w");
+        CHECK(lines.next().status == pc::Status::rejected);
+    }
+
+    SECTION("items that consume nothing fail rather than repeat forever") {
+        auto empty = pc::incremental(pc::tag_view(""));
+        empty.feed("abc");
+        empty.finish();
+        CHECK(empty.next().status == pc::Status::rejected);
+    }
+
+    SECTION("chunk boundaries do not change the items parsed") {
+        const auto input = "first line\nsecond\n\nthe fourth line is a bit longer\nlast"sv;
+        const std::vector<std::string> expected = {"first line", "second", "", "the fourth line is a bit longer", "last"};
+        for (std::size_t chunk_size = 1; chunk_size <= input.size(); ++chunk_size) {
+            REQUIRE(items_in_chunks(pc::line, input, chunk_size) == expected);
+        }
+    }
+
+    SECTION("chunk boundaries do not change the items of a choice between tags sharing a start") {
+        const auto input = "aabcabcaab"sv;
+        const auto tags = pc::choice(pc::tag_view("abc"), pc::tag_view("ab"), pc::tag_view("a"));
+        const std::vector<std::string_view> expected = {"a", "abc", "abc", "a", "ab"};
+        const std::vector<std::size_t> keywords = {0, 2, 2, 0, 1};
+        for (std::size_t chunk_size = 1; chunk_size <= input.size(); ++chunk_size) {
+            // the views point into the buffer, which is gone once the stream ends, so they are compared as strings
+            const auto items = items_in_chunks(pc::map(tags, [](std::string_view tag) { return std::string(tag); }), input, chunk_size);
+            REQUIRE(items == std::vector<std::string>(expected.begin(), expected.end()));
+            REQUIRE(items_in_chunks(pc::one_of_tags({"a", "ab", "abc"}), input, chunk_size) == keywords);
+        }
+    }
+}
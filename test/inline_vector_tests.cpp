@@ -0,0 +1,168 @@
+#include <pc/pc.hpp>
+#include <pc/inline_vector.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace {
+    // counts the live instances, so the tests can tell every element constructed was destroyed too
+    struct Tracked {
+        static inline int live = 0;
+
+        std::string value;
+
+        explicit Tracked(std::string v) : value(std::move(v)) {
+            ++live;
+        }
+        Tracked(const Tracked& other) : value(other.value) {
+            ++live;
+        }
+        Tracked(Tracked&& other) noexcept : value(std::move(other.value)) {
+            ++live;
+        }
+        auto operator=(const Tracked&) -> Tracked& = default;
+        auto operator=(Tracked&&) noexcept -> Tracked& = default;
+        ~Tracked() {
+            --live;
+        }
+
+        auto operator==(const Tracked& other) const -> bool {
+            return value == other.value;
+        }
+    };
+
+    // an element whose move throws once throwing is set
+    struct ThrowsOnMove {
+        static inline bool throwing = false;
+
+        int value = 0;
+
+        ThrowsOnMove() = default;
+        ThrowsOnMove(const ThrowsOnMove&) = default;
+        ThrowsOnMove(ThrowsOnMove&& other) : value(other.value) {
+            if (throwing) {
+                throw std::runtime_error("move");
+            }
+        }
+        auto operator=(const ThrowsOnMove&) -> ThrowsOnMove& = default;
+        auto operator=(ThrowsOnMove&&) -> ThrowsOnMove& = default;
+    };
+}
+
+TEST_CASE("InlineVector", "[inline_vector]") {
+    SECTION("empty") {
+        const pc::InlineVector<int, 4> v;
+        CHECK(v.empty());
+        CHECK(v.size() == 0);
+        CHECK(v.capacity() == 4);
+        CHECK(v.is_inline());
+        CHECK(v.begin() == v.end());
+    }
+
+    SECTION("up to N elements stay inline") {
+        pc::InlineVector<int, 4> v;
+        for (int i = 0; i < 4; ++i) {
+            v.push_back(i);
+        }
+        CHECK(v.is_inline());
+        CHECK(v == pc::InlineVector<int, 4>{0, 1, 2, 3});
+        CHECK(v.front() == 0);
+        CHECK(v.back() == 3);
+    }
+
+    SECTION("growing past N moves to the heap") {
+        pc::InlineVector<int, 2> v;
+        for (int i = 0; i < 100; ++i) {
+            v.push_back(i);
+        }
+        CHECK(!v.is_inline());
+        REQUIRE(v.size() == 100);
+        for (int i = 0; i < 100; ++i) {
+            CHECK(v[static_cast<std::size_t>(i)] == i);
+        }
+    }
+
+    SECTION("no inline capacity") {
+        pc::InlineVector<int, 0> v;
+        v.push_back(1);
+        v.push_back(2);
+        CHECK(v == pc::InlineVector<int, 0>{1, 2});
+    }
+
+    SECTION("pushing one of its own elements while growing") {
+        pc::InlineVector<std::string, 1> v{"a long string that does not fit the small string buffer"};
+        v.push_back(v[0]);
+        REQUIRE(v.size() == 2);
+        CHECK(v[1] == v[0]);
+    }
+
+    SECTION("move-only elements") {
+        pc::InlineVector<std::unique_ptr<int>, 1> v;
+        v.push_back(std::make_unique<int>(1));
+        v.emplace_back(std::make_unique<int>(2));
+        pc::InlineVector<std::unique_ptr<int>, 1> moved = std::move(v);
+        CHECK(v.empty());
+        REQUIRE(moved.size() == 2);
+        CHECK(*moved[1] == 2);
+    }
+
+    SECTION("copies and moves, inline and on the heap") {
+        {
+            pc::InlineVector<Tracked, 2> small;
+            small.emplace_back("a");
+            pc::InlineVector<Tracked, 2> large;
+            for (int i = 0; i < 5; ++i) {
+                large.emplace_back(std::to_string(i));
+            }
+
+            pc::InlineVector<Tracked, 2> copy = small;
+            CHECK(copy == small);
+            copy = large;
+            CHECK(copy == large);
+
+            pc::InlineVector<Tracked, 2> moved = std::move(small);
+            CHECK(small.empty());
+            REQUIRE(moved.size() == 1);
+            CHECK(moved[0].value == "a");
+
+            moved = std::move(large);
+            CHECK(large.empty());
+            CHECK(!moved.is_inline());
+            CHECK(moved.size() == 5);
+
+            moved.pop_back();
+            CHECK(moved.back().value == "3");
+            moved.clear();
+            CHECK(moved.empty());
+        }
+        CHECK(Tracked::live == 0);
+    }
+
+    SECTION("moves throw where moving the elements can") {
+        static_assert(std::is_nothrow_move_constructible_v<pc::InlineVector<Tracked, 2>>);
+        static_assert(std::is_nothrow_move_assignable_v<pc::InlineVector<Tracked, 2>>);
+        static_assert(!std::is_nothrow_move_constructible_v<pc::InlineVector<ThrowsOnMove, 2>>);
+        static_assert(!std::is_nothrow_move_assignable_v<pc::InlineVector<ThrowsOnMove, 2>>);
+
+        using Vector = pc::InlineVector<ThrowsOnMove, 2>;
+        Vector v;
+        v.emplace_back();
+        ThrowsOnMove::throwing = true;
+        CHECK_THROWS_AS(Vector(std::move(v)), std::runtime_error);
+        ThrowsOnMove::throwing = false;
+    }
+
+    SECTION("reserve") {
+        pc::InlineVector<int, 4> v{1, 2};
+        v.reserve(3);
+        CHECK(v.is_inline());
+        v.reserve(10);
+        CHECK(!v.is_inline());
+        CHECK(v.capacity() == 10);
+        CHECK(v == pc::InlineVector<int, 4>{1, 2});
+    }
+}
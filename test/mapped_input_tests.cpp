@@ -0,0 +1,84 @@
+#include <pc/pc.hpp>
+#include <pc/parsers.hpp>
+#include <pc/combinators.hpp>
+#include <pc/mapped_input.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace pc {
+    using namespace combinators;
+    using namespace parsers;
+}
+using namespace std::literals::string_view_literals;
+
+namespace {
+    auto write_file(std::string_view name, std::string_view content) -> std::filesystem::path {
+        auto path = std::filesystem::temp_directory_path() / name;
+        std::ofstream(path, std::ios::binary) << content;
+        return path;
+    }
+}
+
+TEST_CASE("MappedInput", "[mapped_input]") {
+    SECTION("missing file") {
+        CHECK(!pc::MappedInput::open(std::filesystem::temp_directory_path() / "pc_mapped_input_missing.txt"));
+    }
+
+    SECTION("directories are not files") {
+        CHECK(!pc::MappedInput::open(std::filesystem::temp_directory_path()));
+    }
+
+    SECTION("empty file") {
+        const auto path = write_file("pc_mapped_input_empty.txt", "");
+        const auto input = pc::MappedInput::open(path);
+        REQUIRE(input);
+        CHECK(input->view() == ""sv);
+        std::filesystem::remove(path);
+    }
+
+    SECTION("file contents") {
+        const auto path = write_file("pc_mapped_input_contents.txt", "hello\nworld\n");
+        const auto input = pc::MappedInput::open(path);
+        REQUIRE(input);
+        CHECK(input->view() == "hello\nworld\n"sv);
+        std::filesystem::remove(path);
+    }
+
+    SECTION("moving keeps the mapping alive") {
+        const auto path = write_file("pc_mapped_input_move.txt", "hello");
+        auto input = pc::MappedInput::open(path);
+        REQUIRE(input);
+        pc::MappedInput moved = std::move(*input);
+        CHECK(moved.view() == "hello"sv);
+        std::filesystem::remove(path);
+    }
+}
+
+TEST_CASE("parse_file", "[mapped_input]") {
+    SECTION("missing file") {
+        CHECK(!pc::parse_file(std::filesystem::temp_directory_path() / "pc_parse_file_missing.txt", pc::line_view));
+    }
+
+    SECTION("parse failure") {
+        const auto path = write_file("pc_parse_file_failure.txt", "world");
+        const auto parsed = pc::parse_file(path, pc::tag_view("hello"));
+        REQUIRE(parsed);
+        CHECK(!parsed->result);
+        std::filesystem::remove(path);
+    }
+
+    SECTION("zero copy results point into the mapping") {
+        const auto path = write_file("pc_parse_file_lines.txt", "hello\nworld\n");
+        const auto parsed = pc::parse_file(path, pc::many0(pc::line_view));
+        REQUIRE(parsed);
+        REQUIRE(parsed->result);
+        CHECK(parsed->result->first == std::vector<std::string_view>{"hello", "world"});
+        CHECK(parsed->result->first[0].data() == parsed->input.view().data());
+        CHECK(parsed->result->second == ""sv);
+        std::filesystem::remove(path);
+    }
+}
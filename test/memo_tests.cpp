@@ -0,0 +1,140 @@
+#include <pc/pc.hpp>
+#include <pc/parsers.hpp>
+#include <pc/combinators.hpp>
+#include <pc/memo.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <string_view>
+
+namespace pc {
+    using namespace combinators;
+    using namespace parsers;
+}
+using namespace std::literals::string_view_literals;
+
+namespace {
+    // tag("hello"), counting how often it actually runs
+    auto counted_hello(std::size_t& calls) {
+        return [&calls](std::string_view input) -> pc::Result<std::string_view> {
+            ++calls;
+            return pc::tag_view("hello")(input);
+        };
+    }
+}
+
+TEST_CASE("memo", "[memo]") {
+    pc::MemoContext context;
+    std::size_t calls = 0;
+    const auto hello = pc::memo(context, counted_hello(calls));
+
+    SECTION("backtracking reuses the memoized result") {
+        const auto parser = pc::choice(
+            pc::map(pc::pair(hello, pc::tag('!')), [](auto p) { return p.first; }),
+            pc::map(pc::pair(hello, pc::tag('?')), [](auto p) { return p.first; }));
+        const auto result = parser("hello?"sv);
+        REQUIRE(result);
+        CHECK(result->first == "hello"sv);
+        CHECK(result->second == ""sv);
+        CHECK(calls == 1);
+        CHECK(context.hits() == 1);
+        CHECK(context.misses() == 1);
+    }
+
+    SECTION("failures are memoized with their error") {
+        constexpr auto input = "world"sv;
+        const auto first = hello(input);
+        const auto second = hello(input);
+        REQUIRE(!first);
+        REQUIRE(!second);
+        CHECK(calls == 1);
+        CHECK(second.error().offset(input) == 0);
+        CHECK(second.error().expected(0) == "hello"sv);
+    }
+
+    SECTION("a different end of input is a different key") {
+        constexpr auto input = "hello world"sv;
+        const auto whole = hello(input);
+        const auto prefix = hello(input.substr(0, 5));
+        REQUIRE(whole);
+        REQUIRE(prefix);
+        CHECK(whole->second == " world"sv);
+        CHECK(prefix->second == ""sv);
+        CHECK(calls == 2);
+    }
+
+    SECTION("reset forgets every result") {
+        constexpr auto input = "hello"sv;
+        hello(input);
+        context.reset();
+        hello(input);
+        CHECK(calls == 2);
+    }
+
+    SECTION("the first set and recognizer of the parser are kept") {
+        const auto tag = pc::memo(context, pc::tag("hello"));
+        static_assert(pc::HasFirstSet<decltype(tag)>);
+        static_assert(pc::HasRecognizer<decltype(tag)>);
+        CHECK(tag.first_set() == pc::CharClass("h"));
+
+        const auto parser = pc::choice(pc::tag("world"), tag);
+        CHECK(parser("hello"sv)->first == "hello");
+        CHECK(pc::recognize(parser)("hello!"sv)->first == "hello"sv);
+    }
+
+    SECTION("recognizing reuses the memoized results") {
+        constexpr auto input = "hello"sv;
+        hello(input);
+        const auto twice = pc::recognize(pc::choice(pc::pair(hello, pc::tag("!")), pc::pair(hello, pc::tag(""))));
+        CHECK(twice(input)->first == input);
+        CHECK(calls == 1);
+    }
+
+    SECTION("every rule has a table of its own") {
+        std::size_t other_calls = 0;
+        const auto other = pc::memo(context, counted_hello(other_calls));
+        constexpr auto input = "hello"sv;
+        hello(input);
+        other(input);
+        CHECK(calls == 1);
+        CHECK(other_calls == 1);
+    }
+
+    SECTION("copies of a rule share its table, and a grammar built again starts empty") {
+        constexpr auto input = "hello"sv;
+        const auto copy = hello;
+        hello(input);
+        copy(input);
+        CHECK(calls == 1);
+
+        for (std::size_t i = 0; i < 1000; ++i) {
+            std::size_t rebuilt_calls = 0;
+            const auto rebuilt = pc::memo(context, counted_hello(rebuilt_calls));
+            rebuilt(input);
+            rebuilt(input);
+            CHECK(rebuilt_calls == 1);
+        }
+    }
+}
+
+TEST_CASE("memo with a single slot", "[memo]") {
+    pc::MemoContext context(1);
+    std::size_t calls = 0;
+    const auto hello = pc::memo(context, counted_hello(calls));
+    constexpr auto input = "hellohello"sv;
+
+    SECTION("an evicted result is parsed again") {
+        const auto first = hello(input);
+        const auto second = hello(input.substr(5));
+        const auto again = hello(input);
+        REQUIRE(first);
+        REQUIRE(second);
+        REQUIRE(again);
+        CHECK(again->second == "hello"sv);
+        CHECK(calls == 3);
+    }
+
+    SECTION("slots round up to a power of two") {
+        CHECK(pc::MemoContext(1000).slots() == 1024);
+        CHECK(context.slots() == 1);
+    }
+}
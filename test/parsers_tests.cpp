@@ -2,7 +2,19 @@
 #include <pc/pc.hpp>
 #include <pc/parsers.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <string>
 #include <string_view>
+#include <system_error>
+#include <type_traits>
 
 namespace pc {
     using namespace parsers;
@@ -136,6 +148,41 @@ TEST_CASE("line", "[parsers]") {
     }
 }
 
+TEST_CASE("line_view", "[parsers]") {
+    SECTION("empty input") {
+        const auto result = pc::line_view(""sv);
+        REQUIRE(!result);
+    }
+
+    SECTION("one character input, newline character") {
+        const auto result = pc::line_view("\n"sv);
+        REQUIRE(result);
+        CHECK(result->first == ""sv);
+        CHECK(result->second == ""sv);
+    }
+
+    SECTION("many character input") {
+        const auto result = pc::line_view("hello"sv);
+        REQUIRE(result);
+        CHECK(result->first == "hello"sv);
+        CHECK(result->second == ""sv);
+    }
+
+    SECTION("many character input, newline in middle") {
+        const auto result = pc::line_view("hello\nworld"sv);
+        REQUIRE(result);
+        CHECK(result->first == "hello"sv);
+        CHECK(result->second == "world"sv);
+    }
+
+    SECTION("value is a slice of the input") {
+        const auto input = "hello\nworld"sv;
+        const auto result = pc::line_view(input);
+        REQUIRE(result);
+        CHECK(result->first.data() == input.data());
+    }
+}
+
 TEST_CASE("tag", "[parsers]") {
     SECTION("empty input") {
         const auto result = pc::tag("hello")("");
@@ -193,6 +240,93 @@ TEST_CASE("tag", "[parsers]") {
     }
 }
 
+TEST_CASE("tag<literal>", "[parsers]") {
+    // the parser and its value hold no state, the literal lives in their types
+    static_assert(std::is_empty_v<decltype(pc::tag<"hello">())>);
+    static_assert(std::is_empty_v<pc::Tag<"hello">>);
+    static_assert(pc::Tag<"hello">::text == "hello"sv);
+    static_assert(pc::tag<"hello">().first_set() == pc::CharClass("h"));
+    static_assert(pc::tag<"">().first_set() == pc::any_first_set);
+
+    SECTION("match") {
+        const auto result = pc::tag<"hello">()("hello world"sv);
+        REQUIRE(result);
+        CHECK(result->first == pc::Tag<"hello">());
+        CHECK(result->second == " world"sv);
+    }
+
+    SECTION("no match") {
+        constexpr auto input = "help"sv;
+        const auto result = pc::tag<"hello">()(input);
+        REQUIRE(!result);
+        CHECK(result.error().offset(input) == 0);
+        CHECK(result.error().expected(0) == "hello"sv);
+    }
+
+    SECTION("input shorter than the literal") {
+        CHECK(!pc::tag<"hello">()("hell"sv));
+    }
+
+    SECTION("empty literal") {
+        CHECK(pc::tag<"">()(""sv));
+    }
+
+    SECTION("every length of word and every mismatching byte") {
+        const auto check = [](auto parser, std::string_view literal) {
+            std::string input(literal);
+            input += "...";
+            REQUIRE(parser(input));
+            for (std::size_t i = 0; i < literal.size(); ++i) {
+                input[i] = static_cast<char>(input[i] ^ 1);
+                REQUIRE(!parser(input));
+                input[i] = static_cast<char>(input[i] ^ 1);
+            }
+        };
+        check(pc::tag<"a">(), "a");
+        check(pc::tag<"ab">(), "ab");
+        check(pc::tag<"abc">(), "abc");
+        check(pc::tag<"abcd">(), "abcd");
+        check(pc::tag<"abcdefg">(), "abcdefg");
+        check(pc::tag<"abcdefgh">(), "abcdefgh");
+        check(pc::tag<"abcdefghi">(), "abcdefghi");
+        check(pc::tag<"abcdefghijklmnop">(), "abcdefghijklmnop");
+        check(pc::tag<"abcdefghijklmnopqrstuvwxyz">(), "abcdefghijklmnopqrstuvwxyz");
+    }
+}
+
+TEST_CASE("tag_view", "[parsers]") {
+    SECTION("empty input") {
+        const auto result = pc::tag_view("hello")("");
+        REQUIRE(!result);
+    }
+
+    SECTION("empty input, empty tag") {
+        const auto result = pc::tag_view("")("");
+        REQUIRE(result);
+        CHECK(result->first == ""sv);
+        CHECK(result->second == ""sv);
+    }
+
+    SECTION("non matching input") {
+        const auto result = pc::tag_view("hello")("helo");
+        REQUIRE(!result);
+    }
+
+    SECTION("matching input, extra after") {
+        const auto result = pc::tag_view("hello")("hello123");
+        REQUIRE(result);
+        CHECK(result->first == "hello"sv);
+        CHECK(result->second == "123"sv);
+    }
+
+    SECTION("value is a slice of the input") {
+        const auto input = "hello123"sv;
+        const auto result = pc::tag_view("hello")(input);
+        REQUIRE(result);
+        CHECK(result->first.data() == input.data());
+    }
+}
+
 TEST_CASE("tag<char>", "[parsers]") {
     SECTION("empty input") {
         const auto result = pc::tag('h')("");
@@ -236,6 +370,388 @@ TEST_CASE("tag<char>", "[parsers]") {
     }
 }
 
+static_assert(pc::char_classes::digit == pc::CharClass::range('0', '9'));
+static_assert(pc::char_classes::hex_digit.contains('F') && !pc::char_classes::hex_digit.contains('g'));
+static_assert(pc::char_classes::alnum.contains('z') && !pc::char_classes::alnum.contains('_'));
+TEST_CASE("take_while0", "[parsers]") {
+    SECTION("empty input") {
+        const auto result = pc::take_while0(pc::char_classes::digit)(""sv);
+        REQUIRE(result);
+        CHECK(result->first == ""sv);
+        CHECK(result->second == ""sv);
+    }
+
+    SECTION("no match") {
+        const auto result = pc::take_while0(pc::char_classes::digit)("hello"sv);
+        REQUIRE(result);
+        CHECK(result->first == ""sv);
+        CHECK(result->second == "hello"sv);
+    }
+
+    SECTION("match, extra after") {
+        const auto result = pc::take_while0(pc::char_classes::digit)("123hello"sv);
+        REQUIRE(result);
+        CHECK(result->first == "123"sv);
+        CHECK(result->second == "hello"sv);
+    }
+
+    SECTION("match longer than a vector register") {
+        const std::string identifier = "abcdefghijklmnopqrstuvwxyz_ABCDEFGHIJKLMNOPQRSTUVWXYZ_0123456789";
+        const std::string input = identifier + " = 1";
+        const auto result = pc::take_while0(pc::char_classes::alnum | pc::CharClass("_"))(input);
+        REQUIRE(result);
+        CHECK(result->first == identifier);
+        CHECK(result->second == " = 1"sv);
+    }
+
+    SECTION("value is a slice of the input") {
+        const auto input = "ff00 hello"sv;
+        const auto result = pc::take_while0(pc::char_classes::hex_digit)(input);
+        REQUIRE(result);
+        CHECK(result->first.data() == input.data());
+        CHECK(result->first == "ff00"sv);
+    }
+}
+
+TEST_CASE("take_while1", "[parsers]") {
+    SECTION("empty input") {
+        const auto result = pc::take_while1(pc::char_classes::digit)(""sv);
+        REQUIRE(!result);
+    }
+
+    SECTION("no match") {
+        const auto result = pc::take_while1(pc::char_classes::digit)("hello"sv);
+        REQUIRE(!result);
+    }
+
+    SECTION("match whole input") {
+        const auto result = pc::take_while1(pc::char_classes::digit)("123"sv);
+        REQUIRE(result);
+        CHECK(result->first == "123"sv);
+        CHECK(result->second == ""sv);
+    }
+
+    SECTION("match, extra after") {
+        const auto result = pc::take_while1(pc::CharClass("ab"))("abba cd"sv);
+        REQUIRE(result);
+        CHECK(result->first == "abba"sv);
+        CHECK(result->second == " cd"sv);
+    }
+}
+
+TEST_CASE("one_of_tags", "[parsers]") {
+    const auto verbs = pc::one_of_tags({"GET", "HEAD", "POST", "PUT", "PATCH", "DELETE"});
+
+    SECTION("the index of the tag matched") {
+        const auto result = verbs("POST /index.html"sv);
+        REQUIRE(result);
+        CHECK(result->first == 2);
+        CHECK(result->second == " /index.html"sv);
+    }
+
+    SECTION("tags sharing a prefix") {
+        CHECK(verbs("PUT"sv)->first == 3);
+        CHECK(verbs("PATCH"sv)->first == 4);
+        CHECK(!verbs("PA"sv));
+        CHECK(!verbs("PUSH"sv));
+    }
+
+    SECTION("no match") {
+        constexpr auto input = "get"sv;
+        const auto result = verbs(input);
+        REQUIRE(!result);
+        CHECK(result.error().offset(input) == 0);
+        CHECK(!verbs(""sv));
+    }
+
+    SECTION("the longest tag wins whatever the order") {
+        const auto keywords = pc::one_of_tags({"do", "double", "d"});
+        const auto result = keywords("doubled"sv);
+        REQUIRE(result);
+        CHECK(result->first == 1);
+        CHECK(result->second == "d"sv);
+        CHECK(keywords("doub"sv)->first == 0);
+        CHECK(keywords("d"sv)->first == 2);
+    }
+
+    SECTION("the first of duplicate tags wins") {
+        CHECK(pc::one_of_tags({"a", "b", "a"})("a"sv)->first == 0);
+    }
+
+    SECTION("the empty tag matches anywhere") {
+        const auto parser = pc::one_of_tags({"", "ab"});
+        CHECK(parser("ac"sv)->first == 0);
+        CHECK(parser("ab"sv)->first == 1);
+        CHECK(parser(""sv)->first == 0);
+        CHECK(parser.first_set() == pc::any_first_set);
+    }
+
+    SECTION("no tags") {
+        CHECK(!pc::one_of_tags({})("abc"sv));
+    }
+
+    SECTION("the first set is the first byte of every tag") {
+        CHECK(verbs.first_set() == pc::CharClass("GHPD"));
+    }
+}
+
+namespace {
+    // parses every prefix of input with integer<T>() and with std::from_chars, checking they agree on the value, on
+    // where the number ends and on whether it is out of range
+    template <typename T>
+    void check_against_from_chars(std::string_view input) {
+        const auto result = pc::integer<T>()(input);
+        T expected{};
+        const auto [end, error] = std::from_chars(input.data(), input.data() + input.size(), expected);
+        if (error == std::errc::invalid_argument) {
+            CHECK(!result);
+        } else if (error == std::errc::result_out_of_range) {
+            REQUIRE(!result);
+            CHECK(result.error().offset(input) == 0);
+        } else {
+            REQUIRE(result);
+            CHECK(result->first == expected);
+            CHECK(result->second.data() == end);
+        }
+    }
+}
+
+TEST_CASE("integer", "[parsers]") {
+    static_assert(pc::AnyParser<decltype(pc::integer<int>())>);
+    static_assert(std::is_same_v<pc::ParserValueType<decltype(pc::integer<std::uint8_t>())>, std::uint8_t>);
+
+    SECTION("digits up to the first non digit") {
+        const auto result = pc::integer<int>()("12345,"sv);
+        REQUIRE(result);
+        CHECK(result->first == 12345);
+        CHECK(result->second == ","sv);
+    }
+
+    SECTION("longer than a word") {
+        const auto result = pc::integer<std::uint64_t>()("12345678901234567 "sv);
+        REQUIRE(result);
+        CHECK(result->first == 12345678901234567u);
+        CHECK(result->second == " "sv);
+    }
+
+    SECTION("negative") {
+        const auto result = pc::integer<std::int32_t>()("-42"sv);
+        REQUIRE(result);
+        CHECK(result->first == -42);
+        CHECK(result->second == ""sv);
+    }
+
+    SECTION("unsigned integers have no sign") {
+        constexpr auto input = "-42"sv;
+        const auto result = pc::integer<unsigned>()(input);
+        REQUIRE(!result);
+        CHECK(result.error().offset(input) == 0);
+        CHECK(result.error().expected(0) == "an integer"sv);
+    }
+
+    SECTION("a sign alone is no integer") {
+        CHECK(!pc::integer<int>()("-"sv));
+        CHECK(!pc::integer<int>()("-x"sv));
+        CHECK(!pc::integer<int>()("+1"sv));
+        CHECK(!pc::integer<int>()(""sv));
+    }
+
+    SECTION("leading zeros") {
+        CHECK(pc::integer<std::uint8_t>()("000000000000000000000000255"sv)->first == 255);
+        CHECK(pc::integer<int>()("-0"sv)->first == 0);
+    }
+
+    SECTION("the limits of every width") {
+        CHECK(pc::integer<std::int8_t>()("-128"sv)->first == -128);
+        CHECK(pc::integer<std::int8_t>()("127"sv)->first == 127);
+        CHECK(pc::integer<std::uint8_t>()("255"sv)->first == 255);
+        CHECK(pc::integer<std::int16_t>()("-32768"sv)->first == -32768);
+        CHECK(pc::integer<std::uint16_t>()("65535"sv)->first == 65535);
+        CHECK(pc::integer<std::int32_t>()("-2147483648"sv)->first == std::numeric_limits<std::int32_t>::min());
+        CHECK(pc::integer<std::uint32_t>()("4294967295"sv)->first == std::numeric_limits<std::uint32_t>::max());
+        CHECK(pc::integer<std::int64_t>()("-9223372036854775808"sv)->first == std::numeric_limits<std::int64_t>::min());
+        CHECK(pc::integer<std::int64_t>()("9223372036854775807"sv)->first == std::numeric_limits<std::int64_t>::max());
+        CHECK(pc::integer<std::uint64_t>()("18446744073709551615"sv)->first == std::numeric_limits<std::uint64_t>::max());
+    }
+
+    SECTION("overflow fails at the start of the number") {
+        constexpr auto input = "-129"sv;
+        const auto result = pc::integer<std::int8_t>()(input);
+        REQUIRE(!result);
+        CHECK(result.error().offset(input) == 0);
+        CHECK(result.error().expected(0) == "an integer in range"sv);
+
+        CHECK(!pc::integer<std::int8_t>()("128"sv));
+        CHECK(!pc::integer<std::int64_t>()("9223372036854775808"sv));
+        CHECK(!pc::integer<std::int64_t>()("-9223372036854775809"sv));
+        CHECK(!pc::integer<std::int64_t>()("99999999999999999999999"sv));
+        CHECK(!pc::integer<std::uint64_t>()("18446744073709551616"sv));
+        CHECK(!pc::integer<std::uint16_t>()("65536"sv));
+    }
+
+    SECTION("agrees with std::from_chars") {
+        const std::string inputs[] = {"0", "7", "-7", "99", "256", "-256", "65535", "65536", "-32769", "12345678", "123456789",
+            "-12345678", "4294967296", "2147483648", "-2147483649", "1234567812345678", "9223372036854775807",
+            "9223372036854775808", "18446744073709551615", "18446744073709551616", "000000001234567800000000", "-",
+            "1234567x9", "12345678x", "-0000000000000000000000000000000001", "123,456789012", "-9876543210987654,xxxxxxxx",
+            "12345678901234567890123456,xxxxxxxx", "0000000000000000000255,xxxxxxxx"};
+        for (const std::string& input : inputs) {
+            for (std::size_t size = 0; size <= input.size(); ++size) {
+                const std::string_view prefix = std::string_view(input).substr(0, size);
+                check_against_from_chars<std::int8_t>(prefix);
+                check_against_from_chars<std::uint8_t>(prefix);
+                check_against_from_chars<std::int16_t>(prefix);
+                check_against_from_chars<std::uint16_t>(prefix);
+                check_against_from_chars<std::int32_t>(prefix);
+                check_against_from_chars<std::uint32_t>(prefix);
+                check_against_from_chars<std::int64_t>(prefix);
+                check_against_from_chars<std::uint64_t>(prefix);
+            }
+        }
+    }
+
+    SECTION("first set") {
+        CHECK(pc::integer<int>().first_set() == (pc::char_classes::digit | pc::CharClass("-")));
+        CHECK(pc::integer<unsigned>().first_set() == pc::char_classes::digit);
+    }
+}
+
+namespace {
+    // parses input with floating_point<T>() and with strtod or strtof, checking they agree to the bit on the value,
+    // out of range numbers included
+    template <typename T>
+    void check_against_strtod(const std::string& input) {
+        const auto result = pc::floating_point<T>()(input);
+        char* end = nullptr;
+        T expected;
+        if constexpr (std::is_same_v<T, float>) {
+            expected = std::strtof(input.c_str(), &end);
+        } else {
+            expected = std::strtod(input.c_str(), &end);
+        }
+        INFO(input);
+        REQUIRE(result);
+        CHECK(std::bit_cast<std::array<unsigned char, sizeof(T)>>(result->first) == std::bit_cast<std::array<unsigned char, sizeof(T)>>(expected));
+        CHECK(result->second.data() == input.data() + (end - input.c_str()));
+    }
+
+    // a random number as JSON or CSV would have it, with up to 25 significant digits and an exponent around the limits
+    // of double
+    auto random_number(std::mt19937_64& random) -> std::string {
+        auto below = [&random](std::uint64_t n) {
+            return static_cast<std::size_t>(random() % n);
+        };
+        std::string number = below(2) == 0 ? "" : "-";
+        for (std::size_t i = below(12) + 1; i > 0; --i) {
+            number.push_back(static_cast<char>('0' + below(10)));
+        }
+        if (below(2) == 0) {
+            number.push_back('.');
+            for (std::size_t i = below(14) + 1; i > 0; --i) {
+                number.push_back(static_cast<char>('0' + below(10)));
+            }
+        }
+        if (below(2) == 0) {
+            number += (below(2) == 0 ? "e" : "E-") + std::to_string(below(340));
+        }
+        return number;
+    }
+}
+
+TEST_CASE("floating_point", "[parsers]") {
+    static_assert(std::is_same_v<pc::ParserValueType<decltype(pc::floating_point<float>())>, float>);
+
+    SECTION("the number up to the first byte that is no part of it") {
+        const auto result = pc::floating_point<double>()("-3.25e2,"sv);
+        REQUIRE(result);
+        CHECK(result->first == -325.0);
+        CHECK(result->second == ","sv);
+    }
+
+    SECTION("integers") {
+        CHECK(pc::floating_point<double>()("42"sv)->first == 42.0);
+        CHECK(pc::floating_point<double>()("-0"sv)->first == 0.0);
+        CHECK(std::signbit(pc::floating_point<double>()("-0"sv)->first));
+    }
+
+    SECTION("csv spellings") {
+        CHECK(pc::floating_point<double>()("+1.5"sv)->first == 1.5);
+        CHECK(pc::floating_point<double>()(".5"sv)->first == 0.5);
+
+        const auto result = pc::floating_point<double>()("5.;"sv);
+        REQUIRE(result);
+        CHECK(result->first == 5.0);
+        CHECK(result->second == ";"sv);
+    }
+
+    SECTION("an exponent without digits is left over") {
+        const auto result = pc::floating_point<double>()("1.5e+x"sv);
+        REQUIRE(result);
+        CHECK(result->first == 1.5);
+        CHECK(result->second == "e+x"sv);
+    }
+
+    SECTION("no number") {
+        for (const auto input : {""sv, "-"sv, "."sv, "-.e1"sv, "e5"sv, "inf"sv, "nan"sv, "x1"sv}) {
+            const auto result = pc::floating_point<double>()(input);
+            REQUIRE(!result);
+            CHECK(result.error().offset(input) == 0);
+            CHECK(result.error().expected(0) == "a number"sv);
+        }
+    }
+
+    SECTION("too large is infinity, as with strtod") {
+        const auto result = pc::floating_point<double>()("1e400,"sv);
+        REQUIRE(result);
+        CHECK(result->first == std::numeric_limits<double>::infinity());
+        CHECK(result->second == ","sv);
+
+        CHECK(pc::floating_point<float>()("1e39"sv)->first == std::numeric_limits<float>::infinity());
+        CHECK(pc::floating_point<double>()("-123456.7e999999999999"sv)->first == -std::numeric_limits<double>::infinity());
+        CHECK(pc::floating_point<double>()("1e0000000000400"sv)->first == std::numeric_limits<double>::infinity());
+        CHECK(pc::floating_point<double>()("0.00001e310"sv)->first == 1e305);
+    }
+
+    SECTION("too small is 0, as with strtod") {
+        const auto result = pc::floating_point<double>()("1e-400"sv);
+        REQUIRE(result);
+        CHECK(result->first == 0.0);
+        CHECK(!std::signbit(result->first));
+
+        CHECK(std::signbit(pc::floating_point<double>()("-1e-400"sv)->first));
+        CHECK(pc::floating_point<float>()("0.0001e-50"sv)->first == 0.0f);
+        CHECK(pc::floating_point<double>()("12345e-999999999999"sv)->first == 0.0);
+        CHECK(pc::floating_point<double>()("4.9e-324"sv)->first == std::numeric_limits<double>::denorm_min());
+        CHECK(pc::floating_point<double>()("0e-999"sv)->first == 0.0);
+    }
+
+    SECTION("agrees with strtod to the bit") {
+        std::mt19937_64 random(20261017);
+        for (std::size_t i = 0; i < 20000; ++i) {
+            const std::string number = random_number(random);
+            check_against_strtod<double>(number);
+            check_against_strtod<float>(number);
+        }
+    }
+
+    SECTION("round trips every double printed to 17 digits") {
+        std::mt19937_64 random(20261017);
+        for (std::size_t i = 0; i < 20000; ++i) {
+            const double value = std::bit_cast<double>(random());
+            if (!std::isfinite(value)) {
+                continue;
+            }
+            std::array<char, 32> printed{};
+            const int size = std::snprintf(printed.data(), printed.size(), "%.17g", value);
+            check_against_strtod<double>(std::string(printed.data(), static_cast<std::size_t>(size)));
+        }
+    }
+
+    SECTION("first set") {
+        CHECK(pc::floating_point<double>().first_set() == (pc::char_classes::digit | pc::CharClass("-+.")));
+    }
+}
+
 TEST_CASE("unit", "[parsers]") {
     SECTION("unit<int> with empty input") {
         const auto result = pc::unit(20)(""sv);
@@ -375,3 +891,60 @@ TEST_CASE("fail", "[parsers]") {
         REQUIRE(!result);
     }
 }
+
+TEST_CASE("failure positions", "[parsers]") {
+    SECTION("tag names its prefix") {
+        constexpr auto input = "hello world"sv;
+        const auto result = pc::tag("world")(input);
+        REQUIRE(!result);
+        CHECK(result.error().offset(input) == 0);
+        REQUIRE(result.error().count() == 1);
+        CHECK(result.error().expected(0) == "world"sv);
+    }
+
+    SECTION("tag<char> names its character") {
+        constexpr auto input = "abc"sv;
+        const auto result = pc::tag('x')(input.substr(1));
+        REQUIRE(!result);
+        CHECK(result.error().offset(input) == 1);
+        REQUIRE(result.error().count() == 1);
+        CHECK(result.error().expected(0) == "x"sv);
+    }
+
+    SECTION("character at the end of the input") {
+        constexpr auto input = "ab"sv;
+        const auto result = pc::character(input.substr(2));
+        REQUIRE(!result);
+        CHECK(result.error().offset(input) == 2);
+        CHECK(result.error().expected(0) == "a character"sv);
+    }
+
+    SECTION("first_char_match fails at the end") {
+        constexpr auto input = "hello"sv;
+        const auto result = pc::first_char_match([](char c) { return c == '\n'; })(input);
+        REQUIRE(!result);
+        CHECK(result.error().offset(input) == 5);
+        CHECK(result.error().count() == 0);
+    }
+
+    SECTION("take_while1 records only the position") {
+        constexpr auto input = "  x"sv;
+        const auto result = pc::take_while1(pc::char_classes::alpha)(input);
+        REQUIRE(!result);
+        CHECK(result.error().offset(input) == 0);
+        CHECK(result.error().count() == 0);
+    }
+
+    SECTION("success carries no error") {
+        const auto result = pc::tag("hello")("hello"sv);
+        REQUIRE(result);
+        CHECK(result.error().position == nullptr);
+        CHECK(result.error().count() == 0);
+    }
+
+    SECTION("failure has no position") {
+        const pc::Result<int> result = pc::failure;
+        REQUIRE(!result);
+        CHECK(!result.error().offset("hello"sv));
+    }
+}
@@ -0,0 +1,220 @@
+#include <pc/pc.hpp>
+#include <pc/parsers.hpp>
+#include <pc/combinators.hpp>
+#include <pc/rule.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <variant>
+#include <vector>
+
+namespace pc {
+    using namespace combinators;
+    using namespace parsers;
+}
+using namespace std::literals::string_view_literals;
+
+namespace {
+    // an integer, or a list of values in brackets
+    struct Value {
+        std::variant<int, std::vector<Value>> value;
+
+        auto operator==(const Value&) const -> bool = default;
+    };
+
+    void define_values(pc::Rule<Value>& value) {
+        value.define(pc::choice(
+            pc::map(pc::integer<int>(), [](int i) { return Value{i}; }),
+            pc::map(pc::delimited(pc::tag('['), pc::many_seperated_by0(value.ref(), pc::tag(',')), pc::tag(']')),
+                    [](std::vector<Value> values) { return Value{std::move(values)}; })));
+    }
+
+    // x in depth parentheses, the value being the depth
+    void define_parentheses(pc::Rule<std::size_t>& nested) {
+        nested.define(pc::choice(
+            pc::map(pc::tag('x'), [](char) -> std::size_t { return 0; }),
+            pc::map(pc::delimited(pc::tag('('), nested.ref(), pc::tag(')')), [](std::size_t depth) { return depth + 1; })));
+    }
+
+    auto parenthesized(std::size_t depth) -> std::string {
+        return std::string(depth, '(') + 'x' + std::string(depth, ')');
+    }
+}
+
+TEST_CASE("Rule", "[rule]") {
+    static_assert(pc::Parser<pc::RuleRef<int>, int>);
+
+    SECTION("a rule referring to itself") {
+        pc::Rule<Value> value(pc::CharClass("-0123456789["));
+        define_values(value);
+
+        const auto result = value("[1,[2,[]],3]!"sv);
+        REQUIRE(result);
+        const Value expected{std::vector<Value>{Value{1}, Value{std::vector<Value>{Value{2}, Value{std::vector<Value>{}}}}, Value{3}}};
+        CHECK(result->first == expected);
+        CHECK(result->second == "!"sv);
+
+        CHECK(value("7"sv)->first == Value{7});
+    }
+
+    SECTION("failures inside the recursion fail the levels above it") {
+        pc::Rule<Value> value(pc::CharClass("-0123456789["));
+        define_values(value);
+
+        // the outer list ends its elements before the one that fails, and then expects its closing bracket
+        constexpr auto input = "[1,[2,x]]"sv;
+        const auto result = value(input);
+        REQUIRE(!result);
+        CHECK(result.error().offset(input) == 2);
+        CHECK(result.error().expected(0) == "]"sv);
+    }
+
+    SECTION("rules referring to each other") {
+        // a is x, or b in parentheses, and b is a in brackets
+        pc::Rule<std::size_t> a(pc::CharClass("x("));
+        pc::Rule<std::size_t> b(pc::CharClass("["));
+        a.define(pc::choice(
+            pc::map(pc::tag('x'), [](char) -> std::size_t { return 0; }),
+            pc::map(pc::delimited(pc::tag('('), b.ref(), pc::tag(')')), [](std::size_t depth) { return depth + 1; })));
+        b.define(pc::map(pc::delimited(pc::tag('['), a.ref(), pc::tag(']')), [](std::size_t depth) { return depth + 1; }));
+
+        CHECK(a("x"sv)->first == 0);
+        CHECK(a("([x])"sv)->first == 2);
+        CHECK(a("([([x])])"sv)->first == 4);
+        CHECK(!a("([(x)])"sv));
+        CHECK(b("[([x])]"sv)->first == 3);
+    }
+
+    SECTION("with many0 and map") {
+        // balanced parentheses, counting the pairs
+        pc::Rule<std::size_t> pairs(pc::CharClass("("));
+        pairs.define(pc::map(pc::delimited(pc::tag('('), pc::many0(pairs.ref()), pc::tag(')')), [](std::vector<std::size_t> inner) {
+            std::size_t count = 1;
+            for (std::size_t n : inner) {
+                count += n;
+            }
+            return count;
+        }));
+
+        const auto result = pc::many0(pairs.ref())("(()())()("sv);
+        REQUIRE(result);
+        CHECK(result->first == std::vector<std::size_t>{3, 1});
+        CHECK(result->second == "("sv);
+    }
+
+    SECTION("choice dispatches on the declared first set") {
+        pc::Rule<std::string_view> rule(pc::CharClass("a"));
+        const auto parser = pc::choice(rule.ref(), pc::tag_view("b"));
+        CHECK(parser.first_set() == pc::CharClass("ab"));
+        rule.define(pc::tag_view("a"));
+        CHECK(parser("a"sv)->first == "a"sv);
+        CHECK(parser("b"sv)->first == "b"sv);
+
+        CHECK(pc::Rule<char>().ref().first_set() == pc::any_first_set);
+    }
+
+    SECTION("recognizes without constructing values") {
+        std::size_t calls = 0;
+        pc::Rule<std::size_t> nested(pc::CharClass("("));
+        nested.define(pc::map(pc::delimited(pc::tag('('), pc::many0(nested.ref()), pc::tag(')')), [&calls](auto) {
+            ++calls;
+            return std::size_t{0};
+        }));
+
+        const auto result = pc::recognize(nested.ref())("(()(()))x"sv);
+        REQUIRE(result);
+        CHECK(result->first == "(()(()))"sv);
+        CHECK(calls == 0);
+    }
+
+    SECTION("an undefined rule fails, a redefined one parses like its new definition") {
+        pc::Rule<std::string_view> rule;
+        constexpr auto input = "abc"sv;
+        const auto failure = rule.ref()(input);
+        REQUIRE(!failure);
+        CHECK(failure.error().offset(input) == 0);
+
+        rule.define(pc::tag_view("a"));
+        CHECK(rule.ref()(input)->first == "a"sv);
+        rule.define(pc::tag_view("ab"));
+        CHECK(rule.ref()(input)->first == "ab"sv);
+    }
+
+    SECTION("nesting deeper than max_depth fails where the limit is reached") {
+        pc::Rule<std::size_t> nested(pc::CharClass("x("), 100);
+        define_parentheses(nested);
+        CHECK(nested.max_depth() == 100);
+
+        CHECK(nested(parenthesized(99))->first == 99);
+
+        const std::string input = parenthesized(100);
+        const auto result = nested(input);
+        REQUIRE(!result);
+        CHECK(result.error().offset(input) == 100);
+        CHECK(result.error().expected(0) == "nesting within the depth limit"sv);
+        CHECK(pc::rule_depth == 0);
+    }
+
+    SECTION("reaching the depth limit is fatal, a choice takes no other alternative") {
+        pc::Rule<std::size_t> nested(pc::CharClass("x("), 3);
+        define_parentheses(nested);
+
+        CHECK(nested(parenthesized(2))->first == 2);
+
+        // the alternative after the rule would take the whole input
+        const auto parser = pc::choice(nested.ref(), pc::map(pc::take_while1(pc::CharClass("x()")), [](std::string_view) -> std::size_t { return 0; }));
+        const std::string input = parenthesized(3);
+        const auto result = parser(input);
+        REQUIRE(!result);
+        CHECK(result.error().fatal);
+        CHECK(result.error().offset(input) == 3);
+        CHECK(result.error().expected(0) == "nesting within the depth limit"sv);
+    }
+
+    SECTION("reaching the depth limit is fatal, a repetition does not stop short") {
+        pc::Rule<std::size_t> lists(pc::CharClass("["), 3);
+        lists.define(pc::map(pc::delimited(pc::tag('['), pc::many0(lists.ref()), pc::tag(']')),
+            [](std::vector<std::size_t> items) { return items.size(); }));
+
+        CHECK(lists("[[][[]]]"sv)->first == 2);
+        CHECK(pc::many0(lists.ref())("[][[]]"sv)->first == std::vector<std::size_t>{0, 1});
+
+        constexpr auto input = "[][[[[]]]]"sv;
+        const auto result = pc::many0(lists.ref())(input);
+        REQUIRE(!result);
+        CHECK(result.error().fatal);
+        CHECK(result.error().offset(input) == 5);
+        CHECK(!pc::many_seperated_by0_fold(lists.ref(), pc::tag(','), 0, [](int n, std::size_t) { return n + 1; })("[],[[[[]]]]"sv));
+        CHECK(!pc::recognize(pc::many1(lists.ref()))(input));
+    }
+
+    SECTION("a failure deep inside nested choices is reported without parsing again at every level") {
+        pc::Rule<std::size_t> nested(pc::CharClass("x("));
+        define_parentheses(nested);
+
+        std::string input = parenthesized(1000);
+        input[1000] = 'y';
+        const auto result = nested(input);
+        REQUIRE(!result);
+        CHECK(result.error().offset(input) == 1000);
+    }
+
+    SECTION("nesting deeper than the stack of the thread") {
+        pc::Rule<std::size_t> nested(pc::CharClass("x("));
+        define_parentheses(nested);
+
+        // several hundred bytes of stack a level, far more than the usual 8MB stack holds
+        const std::string input = parenthesized(100000);
+        CHECK(nested(input)->first == 100000);
+        CHECK(pc::recognize(nested.ref())(input)->first.size() == input.size());
+
+        std::size_t depth = 0;
+        std::thread thread([&nested, &input, &depth]() {
+            depth = nested(input)->first;
+        });
+        thread.join();
+        CHECK(depth == 100000);
+    }
+}
@@ -0,0 +1,100 @@
+#include <pc/simd.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <string_view>
+
+using namespace std::literals::string_view_literals;
+
+TEST_CASE("find", "[simd]") {
+    SECTION("empty input") {
+        CHECK(pc::simd::find(""sv, '\n') == 0);
+    }
+
+    SECTION("no match") {
+        CHECK(pc::simd::find("hello"sv, '\n') == 5);
+        CHECK(pc::simd::find(std::string(100, 'a'), '\n') == 100);
+    }
+
+    SECTION("first of many matches") {
+        CHECK(pc::simd::find("hello\nworld\n"sv, '\n') == 5);
+    }
+
+    SECTION("match at every position of inputs spanning several vector registers") {
+        for (std::size_t size = 1; size <= 100; ++size) {
+            for (std::size_t position = 0; position < size; ++position) {
+                std::string input(size, 'a');
+                input[position] = '\n';
+                REQUIRE(pc::simd::find(input, '\n') == position);
+            }
+        }
+    }
+
+    SECTION("bytes with the high bit set") {
+        std::string input(40, '\xff');
+        input[37] = '\x80';
+        CHECK(pc::simd::find(input, '\x80') == 37);
+    }
+}
+
+TEST_CASE("prefix_length", "[simd]") {
+    const auto whitespace = pc::char_classes::whitespace;
+
+    SECTION("empty input") {
+        CHECK(pc::simd::prefix_length(""sv, whitespace) == 0);
+    }
+
+    SECTION("no prefix") {
+        CHECK(pc::simd::prefix_length("hello   "sv, whitespace) == 0);
+    }
+
+    SECTION("whole input") {
+        CHECK(pc::simd::prefix_length(" \t\n "sv, whitespace) == 4);
+        CHECK(pc::simd::prefix_length(std::string(100, ' '), whitespace) == 100);
+    }
+
+    SECTION("prefix of every length of inputs spanning several vector registers") {
+        for (std::size_t size = 1; size <= 100; ++size) {
+            for (std::size_t length = 0; length < size; ++length) {
+                std::string input(size, '\t');
+                input[length] = 'x';
+                REQUIRE(pc::simd::prefix_length(input, whitespace) == length);
+            }
+        }
+    }
+
+    SECTION("every byte value against a class of high and low bytes") {
+        const auto char_class = pc::CharClass("\x01\x7f\x80\xfe") | pc::CharClass::range('a', 'c');
+        for (int byte = 0; byte < 256; ++byte) {
+            std::string input(40, 'a');
+            input[33] = static_cast<char>(byte);
+            const std::size_t expected = char_class.contains(static_cast<char>(byte)) ? 40 : 33;
+            REQUIRE(pc::simd::prefix_length(input, char_class) == expected);
+        }
+    }
+}
+
+TEST_CASE("suffix_length", "[simd]") {
+    const auto whitespace = pc::char_classes::whitespace;
+
+    SECTION("empty input") {
+        CHECK(pc::simd::suffix_length(""sv, whitespace) == 0);
+    }
+
+    SECTION("no suffix") {
+        CHECK(pc::simd::suffix_length("   hello"sv, whitespace) == 0);
+    }
+
+    SECTION("whole input") {
+        CHECK(pc::simd::suffix_length(std::string(100, '\n'), whitespace) == 100);
+    }
+
+    SECTION("suffix of every length of inputs spanning several vector registers") {
+        for (std::size_t size = 1; size <= 100; ++size) {
+            for (std::size_t length = 0; length < size; ++length) {
+                std::string input(size, ' ');
+                input[size - length - 1] = 'x';
+                REQUIRE(pc::simd::suffix_length(input, whitespace) == length);
+            }
+        }
+    }
+}
@@ -0,0 +1,56 @@
+#include <pc/pc.hpp>
+#include <pc/stack.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+    // recurses depth times with a frame of about 2KB each, the sum of the levels coming back up. past max_depth it
+    // throws instead
+    auto recurse(std::size_t depth, std::size_t max_depth = static_cast<std::size_t>(-1)) -> std::size_t {
+        if (depth == 0) {
+            return 0;
+        }
+        if (depth > max_depth) {
+            throw std::runtime_error("too deep");
+        }
+        std::array<volatile char, 2048> frame{};
+        frame[depth % frame.size()] = 1;
+        return pc::with_enough_stack([depth, max_depth]() {
+            return recurse(depth - 1, max_depth);
+        }) + frame[depth % frame.size()];
+    }
+}
+
+TEST_CASE("with_enough_stack", "[stack]") {
+    SECTION("recursion far deeper than the stack of the thread") {
+        // about 80MB of frames, ten times the usual 8MB stack
+        CHECK(recurse(40000) == 40000);
+    }
+
+    SECTION("on other threads too") {
+        std::size_t result = 0;
+        std::thread thread([&result]() {
+            result = recurse(40000);
+        });
+        thread.join();
+        CHECK(result == 40000);
+    }
+
+    SECTION("exceptions thrown on a stack of the heap reach the caller") {
+        CHECK_THROWS_AS(recurse(40000, 30000), std::runtime_error);
+        CHECK(recurse(100) == 100);
+    }
+
+    SECTION("a call on a new stack has that stack to itself") {
+        std::size_t remaining = 0;
+        pc::call_on_new_stack(pc::stack_segment_size, [](void* context) {
+            *static_cast<std::size_t*>(context) = pc::remaining_stack();
+        }, &remaining);
+        CHECK(remaining > 0);
+        CHECK(remaining <= pc::stack_segment_size);
+        CHECK(pc::remaining_stack() > pc::stack_red_zone);
+    }
+}
@@ -0,0 +1,63 @@
+#include <pc/thread_pool.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <cstddef>
+#include <latch>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("parallel_for", "[thread_pool]") {
+    pc::ThreadPool pool(4);
+
+    SECTION("runs every index once") {
+        std::vector<std::atomic<int>> runs(1000);
+        pool.parallel_for(runs.size(), [&](std::size_t i) { ++runs[i]; });
+        for (const std::atomic<int>& count : runs) {
+            CHECK(count == 1);
+        }
+    }
+
+    SECTION("no tasks") {
+        pool.parallel_for(0, [](std::size_t) { FAIL(); });
+    }
+
+    SECTION("nested inside a task") {
+        std::atomic<std::size_t> total = 0;
+        pool.parallel_for(16, [&](std::size_t) {
+            pool.parallel_for(16, [&](std::size_t) { ++total; });
+        });
+        CHECK(total == 256);
+    }
+
+    SECTION("a throwing task rethrows on the calling thread once every task is done") {
+        std::atomic<std::size_t> runs = 0;
+        CHECK_THROWS_AS(pool.parallel_for(100, [&](std::size_t i) {
+            ++runs;
+            if (i % 10 == 3) {
+                throw std::runtime_error("task failed");
+            }
+        }), std::runtime_error);
+        CHECK(runs == 100);
+    }
+
+    SECTION("single thread") {
+        pc::ThreadPool single(1);
+        std::atomic<std::size_t> total = 0;
+        single.parallel_for(100, [&](std::size_t i) { total += i; });
+        CHECK(total == 4950);
+    }
+}
+
+TEST_CASE("submit", "[thread_pool]") {
+    pc::ThreadPool pool(2);
+    std::latch done(64);
+    std::atomic<int> runs = 0;
+    for (int i = 0; i < 64; ++i) {
+        pool.submit([&] {
+            ++runs;
+            done.count_down();
+        });
+    }
+    done.wait();
+    CHECK(runs == 64);
+}